@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+namespace ednms {
+
+// What to do with accumulated time that exceeds the per-frame catch-up budget.
+enum class OverloadPolicy {
+    DropTicks,   // discard the excess; simulation falls behind wall-clock time
+    CarryDebt    // keep the excess and try to catch up on later frames
+};
+
+struct FixedTimestepConfig {
+    double tickRate = 60.0;            // ticks per second
+    uint32_t maxCatchUpTicks = 5;      // max ticks run for a single Advance()
+    OverloadPolicy overload = OverloadPolicy::DropTicks;
+};
+
+// Accumulator-based fixed-timestep clock.
+// The caller feeds elapsed wall-clock time; Advance() returns how many
+// simulation ticks of TickDuration() should be run this frame.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(const FixedTimestepConfig& config = {})
+        : m_config(config) {
+        m_config.tickRate = std::max(m_config.tickRate, 1e-6);
+        m_config.maxCatchUpTicks = std::max<uint32_t>(m_config.maxCatchUpTicks, 1);
+        m_tickDuration = 1.0 / m_config.tickRate;
+    }
+
+    uint32_t Advance(double elapsedSeconds) {
+        if (elapsedSeconds > 0.0) m_accumulator += elapsedSeconds;
+
+        uint32_t ticks = 0;
+        while (m_accumulator >= m_tickDuration && ticks < m_config.maxCatchUpTicks) {
+            m_accumulator -= m_tickDuration;
+            ++ticks;
+        }
+
+        if (m_accumulator >= m_tickDuration) {
+            const auto behind = static_cast<uint64_t>(m_accumulator / m_tickDuration);
+            if (m_config.overload == OverloadPolicy::DropTicks) {
+                m_droppedTicks += behind;
+                m_accumulator -= static_cast<double>(behind) * m_tickDuration;
+            }
+            ++m_overloadedFrames;
+        }
+
+        m_tick += ticks;
+        return ticks;
+    }
+
+    // Seconds until the next tick is due (0 if one is already pending).
+    double TimeUntilNextTick() const {
+        return std::max(0.0, m_tickDuration - m_accumulator);
+    }
+
+    // Fraction of a tick accumulated but not yet simulated, for interpolation.
+    double Alpha() const { return m_accumulator / m_tickDuration; }
+
+    double TickDuration() const { return m_tickDuration; }
+    uint64_t CurrentTick() const { return m_tick; }
+    uint64_t DroppedTicks() const { return m_droppedTicks; }
+    uint64_t OverloadedFrames() const { return m_overloadedFrames; }
+    const FixedTimestepConfig& Config() const { return m_config; }
+
+private:
+    FixedTimestepConfig m_config;
+    double m_tickDuration = 0.0;
+    double m_accumulator = 0.0;
+    uint64_t m_tick = 0;
+    uint64_t m_droppedTicks = 0;
+    uint64_t m_overloadedFrames = 0;
+};
+
+// Running min/mean/max over per-tick durations (seconds).
+struct TickTimingStats {
+    uint64_t samples = 0;
+    double total = 0.0;
+    double min = std::numeric_limits<double>::max();
+    double max = 0.0;
+    uint64_t overBudget = 0;   // ticks that took longer than the tick duration
+
+    void Record(double seconds, double budget) {
+        ++samples;
+        total += seconds;
+        min = std::min(min, seconds);
+        max = std::max(max, seconds);
+        if (seconds > budget) ++overBudget;
+    }
+
+    double Mean() const { return samples > 0 ? total / static_cast<double>(samples) : 0.0; }
+
+    void Reset() { *this = TickTimingStats{}; }
+};
+
+} // namespace ednms
@@ -1,5 +1,10 @@
 #pragma once
-#include <string>
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
 #include <iostream>
 
 namespace ednms {
@@ -11,9 +16,79 @@ enum class LogLevel {
     Error
 };
 
+// Fixed-point double with an explicit number of decimals, e.g. LogFixed{ms, 3}.
+struct LogFixed {
+    double value;
+    int precision;
+};
+
+// One log line formatted into a fixed buffer (no heap). Pieces are appended
+// in order; integers and doubles go through std::to_chars (doubles print
+// with 6 decimals, matching std::to_string). Overlong lines are truncated.
+class LogLine {
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    template<typename T>
+    LogLine& Append(const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            AppendText(value ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, char>) {
+            AppendText(std::string_view(&value, 1));
+        } else if constexpr (std::is_same_v<T, LogFixed>) {
+            AppendChars(value.value, value.precision);
+        } else if constexpr (std::is_integral_v<T>) {
+            AppendChars(value);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            AppendChars(static_cast<double>(value), 6);
+        } else {
+            AppendText(std::string_view(value));
+        }
+        return *this;
+    }
+
+    template<typename... Args>
+    LogLine& AppendAll(const Args&... args) {
+        (Append(args), ...);
+        return *this;
+    }
+
+    std::string_view View() const { return {m_buffer, m_size}; }
+    bool Truncated() const { return m_truncated; }
+
+private:
+    void AppendText(std::string_view text) {
+        const size_t n = std::min(text.size(), CAPACITY - m_size);
+        std::memcpy(m_buffer + m_size, text.data(), n);
+        m_size += n;
+        m_truncated |= n < text.size();
+    }
+
+    template<typename T>
+    void AppendChars(T value) {
+        auto [end, ec] = std::to_chars(m_buffer + m_size, m_buffer + CAPACITY, value);
+        if (ec == std::errc()) m_size = static_cast<size_t>(end - m_buffer);
+        else m_truncated = true;
+    }
+
+    void AppendChars(double value, int precision) {
+        auto [end, ec] = std::to_chars(m_buffer + m_size, m_buffer + CAPACITY, value,
+                                       std::chars_format::fixed, precision);
+        if (ec == std::errc()) m_size = static_cast<size_t>(end - m_buffer);
+        else m_truncated = true;
+    }
+
+    char m_buffer[CAPACITY];
+    size_t m_size = 0;
+    bool m_truncated = false;
+};
+
+// Variadic calls format on the stack instead of building std::strings:
+//     Log::Info("Ship entity created (ID: ", ship, ")");
+// Only warnings and errors flush the stream.
 class Log {
 public:
-    static void Write(LogLevel level, const std::string& message) {
+    static void Write(LogLevel level, std::string_view message) {
         const char* prefix = "";
         switch (level) {
             case LogLevel::Debug:   prefix = "[DEBUG] ";   break;
@@ -21,13 +96,23 @@ public:
             case LogLevel::Warning: prefix = "[WARN]  ";   break;
             case LogLevel::Error:   prefix = "[ERROR] ";   break;
         }
-        std::cout << prefix << message << std::endl;
+        std::cout.write(prefix, static_cast<std::streamsize>(std::strlen(prefix)));
+        std::cout.write(message.data(), static_cast<std::streamsize>(message.size()));
+        std::cout.put('\n');
+        if (level >= LogLevel::Warning) std::cout.flush();
+    }
+
+    template<typename... Args>
+    static void Format(LogLevel level, const Args&... args) {
+        LogLine line;
+        line.AppendAll(args...);
+        Write(level, line.View());
     }
 
-    static void Debug(const std::string& msg)   { Write(LogLevel::Debug, msg); }
-    static void Info(const std::string& msg)     { Write(LogLevel::Info, msg); }
-    static void Warning(const std::string& msg)  { Write(LogLevel::Warning, msg); }
-    static void Error(const std::string& msg)    { Write(LogLevel::Error, msg); }
+    template<typename... Args> static void Debug(const Args&... args)   { Format(LogLevel::Debug, args...); }
+    template<typename... Args> static void Info(const Args&... args)    { Format(LogLevel::Info, args...); }
+    template<typename... Args> static void Warning(const Args&... args) { Format(LogLevel::Warning, args...); }
+    template<typename... Args> static void Error(const Args&... args)   { Format(LogLevel::Error, args...); }
 };
 
 } // namespace ednms
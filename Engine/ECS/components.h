@@ -1,5 +1,6 @@
 #pragma once
 #include "Engine/ECS/ecs_types.h"
+#include "Engine/ECS/ecs_component_traits.h"
 #include "Engine/Math/Vec3d.h"
 #include <vector>
 
@@ -59,4 +60,52 @@ struct DockingComponent {
     bool locked = false;
 };
 
+// Attaches an entity to another entity's frame (ship module, docked vessel).
+// For attached entities TransformComponent is derived by TransformHierarchy:
+// world = parent world * LocalTransformComponent.
+struct ParentComponent {
+    EntityID parent = INVALID_ENTITY;
+};
+
+struct LocalTransformComponent {
+    Vec3d position;
+    Quatd rotation;
+};
+
+// Stable component IDs. These are ComponentMask bit indices in save files:
+// never renumber or reuse an ID, only append.
+EDNMS_COMPONENT(TransformComponent,      0, 1);
+EDNMS_COMPONENT(PhysicsComponent,        1, 1);
+EDNMS_COMPONENT(SurvivalComponent,       2, 1);
+EDNMS_COMPONENT(PowerComponent,          3, 1);
+EDNMS_COMPONENT(InventoryComponent,      4, 1);
+EDNMS_COMPONENT(OwnershipComponent,      5, 1);
+EDNMS_COMPONENT(ConstructionComponent,   6, 1);
+EDNMS_COMPONENT(DockingComponent,        7, 1);
+EDNMS_COMPONENT(ParentComponent,         8, 1);
+EDNMS_COMPONENT(LocalTransformComponent, 9, 1);
+
+using CoreComponents = ComponentTypeList<
+    TransformComponent,
+    PhysicsComponent,
+    SurvivalComponent,
+    PowerComponent,
+    InventoryComponent,
+    OwnershipComponent,
+    ConstructionComponent,
+    DockingComponent,
+    ParentComponent,
+    LocalTransformComponent>;
+
+// ID-indexed metadata for every registered component, built at compile time.
+inline constexpr std::array<ComponentInfo, MAX_COMPONENTS> COMPONENT_INFO =
+    MakeComponentInfoTable(CoreComponents{});
+
+// Unknown or out-of-range IDs (e.g. read from a damaged save) return an
+// entry with IsValid() == false.
+inline const ComponentInfo& GetComponentInfo(ComponentTypeID id) {
+    static constexpr ComponentInfo INVALID{};
+    return id < MAX_COMPONENTS ? COMPONENT_INFO[id] : INVALID;
+}
+
 } // namespace ednms
@@ -0,0 +1,290 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ecs_types.h"
+#include "ecs_component_traits.h"
+#include "ecs_registry.h"
+
+namespace ednms {
+
+// Deferred structural changes
+// ---------------------------
+// Systems must not create/destroy entities or add/remove components while
+// other systems iterate the registry, least of all from worker threads.
+// Instead each worker records into its own CommandBuffer and the buffers
+// are played back together at the phase barrier:
+//
+//     CommandBufferSet commands(workerCount);
+//     // worker w, processing entity `src`:
+//     CommandBuffer& cb = commands.ForWorker(w);
+//     cb.SetSortKey(src);
+//     EntityID shot = cb.CreateEntity();            // provisional ID
+//     cb.AddComponent(shot, TransformComponent{...});
+//     // barrier:
+//     commands.Playback(registry);
+//
+// Playback order is sorted by (sort key, worker, record order), so the
+// result does not depend on thread timing as long as each sort key (usually
+// the source entity) is recorded by a single worker. Real entity IDs are
+// handed out during playback in that order; provisional IDs returned by
+// CreateEntity() are only valid inside the same CommandBufferSet and can be
+// translated afterwards with Resolve(). Commands that use a provisional ID
+// must share the sort key of the CreateEntity() that produced it.
+//
+// Payload memory: each worker's buffer allocates component payloads from its
+// own memory_resource, so a non-thread-safe resource such as a FrameArena
+// must never be shared between workers:
+//
+//     CommandBufferSet commands({&arenaA, &arenaB}, &mainArena);
+//
+// Playback() and Clear() run the payloads' destructors, which read the
+// payload memory. Play back (or Clear()) every buffer before the arenas it
+// allocates from are Reset(), and before they are destroyed.
+
+// Provisional IDs: [1][worker:31][local index:32]
+static constexpr EntityID PROVISIONAL_ENTITY_BIT = EntityID{1} << 63;
+
+inline bool IsProvisional(EntityID id) {
+    return (id & PROVISIONAL_ENTITY_BIT) != 0;
+}
+
+class CommandBuffer {
+public:
+    explicit CommandBuffer(uint32_t workerIndex = 0,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_workerIndex(workerIndex), m_resource(resource), m_commands(resource) {}
+
+    ~CommandBuffer() { Clear(); }
+
+    CommandBuffer(const CommandBuffer&) = delete;
+    CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+    // Commands recorded after this call sort under `key` (e.g. the source EntityID).
+    void SetSortKey(uint64_t key) { m_sortKey = key; }
+
+    EntityID CreateEntity() {
+        const EntityID provisional = PROVISIONAL_ENTITY_BIT
+            | (EntityID{m_workerIndex & 0x7FFFFFFFu} << 32) | m_createCount++;
+        Record(CommandType::Create, provisional, INVALID_COMPONENT_TYPE, nullptr, nullptr, nullptr, nullptr);
+        return provisional;
+    }
+
+    void DestroyEntity(EntityID id) {
+        Record(CommandType::Destroy, id, INVALID_COMPONENT_TYPE, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    template<typename T>
+    void AddComponent(EntityID id, T component) {
+        void* payload = m_resource->allocate(sizeof(T), alignof(T));
+        new (payload) T(std::move(component));
+        Record(CommandType::Add, id, ComponentID<T>(), payload, &ApplyAdd<T>, &DestroyPayload<T>,
+               &ReserveAdds<T>);
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityID id) {
+        Record(CommandType::Remove, id, ComponentID<T>(), nullptr, &ApplyRemove<T>, nullptr, nullptr);
+    }
+
+    size_t Size() const { return m_commands.size(); }
+    bool Empty() const { return m_commands.empty(); }
+    uint32_t WorkerIndex() const { return m_workerIndex; }
+
+    // Drops recorded commands (and their payloads) without applying them.
+    // The command storage itself is handed back too: it came from the
+    // worker's resource, which may be Reset() right after this.
+    void Clear() {
+        for (Command& cmd : m_commands) {
+            if (cmd.payload && cmd.destroy) cmd.destroy(cmd.payload, m_resource);
+        }
+        std::pmr::vector<Command>(m_resource).swap(m_commands);
+        m_sortKey = 0;
+        m_createCount = 0;
+        m_sequence = 0;
+    }
+
+private:
+    friend class CommandBufferSet;
+
+    enum class CommandType : uint8_t { Create, Destroy, Add, Remove };
+
+    using ApplyFn = void (*)(ECSRegistry&, EntityID, void* payload);
+    using DestroyFn = void (*)(void* payload, std::pmr::memory_resource*);
+    using ReserveFn = void (*)(ECSRegistry&, size_t count);
+
+    struct Command {
+        uint64_t sortKey;
+        uint32_t sequence;
+        CommandType type;
+        ComponentTypeID typeId;
+        EntityID target;
+        void* payload;
+        ApplyFn apply;
+        DestroyFn destroy;
+        ReserveFn reserve;
+    };
+
+    template<typename T>
+    static void ApplyAdd(ECSRegistry& registry, EntityID id, void* payload) {
+        registry.AddComponent(id, *static_cast<const T*>(payload));
+    }
+
+    template<typename T>
+    static void ApplyRemove(ECSRegistry& registry, EntityID id, void*) {
+        registry.RemoveComponent<T>(id);
+    }
+
+    template<typename T>
+    static void ReserveAdds(ECSRegistry& registry, size_t count) {
+        registry.ReserveComponents<T>(count);
+    }
+
+    template<typename T>
+    static void DestroyPayload(void* payload, std::pmr::memory_resource* resource) {
+        static_cast<T*>(payload)->~T();
+        resource->deallocate(payload, sizeof(T), alignof(T));
+    }
+
+    void Record(CommandType type, EntityID target, ComponentTypeID typeId,
+                void* payload, ApplyFn apply, DestroyFn destroy, ReserveFn reserve) {
+        m_commands.push_back({m_sortKey, m_sequence++, type, typeId, target, payload, apply, destroy, reserve});
+    }
+
+    uint32_t m_workerIndex;
+    std::pmr::memory_resource* m_resource;
+    std::pmr::vector<Command> m_commands;
+    uint64_t m_sortKey = 0;
+    uint32_t m_sequence = 0;
+    uint32_t m_createCount = 0;
+};
+
+// One CommandBuffer per worker plus the deterministic merge/playback step.
+class CommandBufferSet {
+public:
+    // Every worker and playback allocate from the (thread-safe) default resource.
+    explicit CommandBufferSet(size_t workerCount)
+        : CommandBufferSet(std::vector<std::pmr::memory_resource*>(workerCount, std::pmr::get_default_resource())) {}
+
+    // One resource per worker, e.g. that worker's FrameArena; workerResources[w]
+    // is only touched by the thread recording into ForWorker(w). Playback
+    // scratch comes from playbackResource on the thread calling Playback();
+    // the Resolve() table is owned by the set and reused between playbacks.
+    explicit CommandBufferSet(const std::vector<std::pmr::memory_resource*>& workerResources,
+                              std::pmr::memory_resource* playbackResource = std::pmr::get_default_resource())
+        : m_resource(playbackResource) {
+        m_buffers.reserve(workerResources.size());
+        for (size_t i = 0; i < workerResources.size(); ++i) {
+            m_buffers.push_back(std::make_unique<CommandBuffer>(static_cast<uint32_t>(i), workerResources[i]));
+        }
+        m_resolved.resize(workerResources.size());
+    }
+
+    CommandBuffer& ForWorker(size_t workerIndex) { return *m_buffers[workerIndex]; }
+    size_t WorkerCount() const { return m_buffers.size(); }
+
+    size_t PendingCommands() const {
+        size_t total = 0;
+        for (const auto& buffer : m_buffers) total += buffer->Size();
+        return total;
+    }
+
+    // Applies every recorded command to `registry` in sorted order, then
+    // clears the buffers (destroying payloads, so worker arenas may be Reset()
+    // afterwards, not before). Commands aimed at entities that no longer exist
+    // (e.g. destroyed earlier in the same playback) are skipped.
+    // Returns the number of commands applied.
+    size_t Playback(ECSRegistry& registry) {
+        struct Ref {
+            const CommandBuffer::Command* cmd;
+            uint32_t worker;
+        };
+        std::pmr::vector<Ref> order(m_resource);
+        order.reserve(PendingCommands());
+
+        size_t creates = 0;
+        std::array<uint32_t, MAX_COMPONENTS> addsPerType{};
+        std::array<CommandBuffer::ReserveFn, MAX_COMPONENTS> reserveFor{};
+        for (const auto& buffer : m_buffers) {
+            for (const auto& cmd : buffer->m_commands) {
+                order.push_back({&cmd, buffer->m_workerIndex});
+                if (cmd.type == CommandBuffer::CommandType::Create) ++creates;
+                if (cmd.type == CommandBuffer::CommandType::Add) {
+                    ++addsPerType[cmd.typeId];
+                    reserveFor[cmd.typeId] = cmd.reserve;
+                }
+            }
+            m_resolved[buffer->m_workerIndex].assign(buffer->m_createCount, INVALID_ENTITY);
+        }
+
+        std::sort(order.begin(), order.end(), [](const Ref& a, const Ref& b) {
+            if (a.cmd->sortKey != b.cmd->sortKey) return a.cmd->sortKey < b.cmd->sortKey;
+            if (a.worker != b.worker) return a.worker < b.worker;
+            return a.cmd->sequence < b.cmd->sequence;
+        });
+
+        // Batch: grow entity and pool storage once instead of per insert.
+        if (creates > 0) registry.ReserveEntities(creates);
+        for (size_t typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+            if (addsPerType[typeId] > 0) {
+                reserveFor[typeId](registry, addsPerType[typeId]);
+            }
+        }
+
+        size_t applied = 0;
+        for (const Ref& ref : order) {
+            const CommandBuffer::Command& cmd = *ref.cmd;
+            if (cmd.type == CommandBuffer::CommandType::Create) {
+                ResolvedSlot(cmd.target) = registry.CreateEntity();
+                ++applied;
+                continue;
+            }
+            const EntityID target = Resolve(cmd.target);
+            if (target == INVALID_ENTITY || !registry.HasEntity(target)) continue;
+            switch (cmd.type) {
+                case CommandBuffer::CommandType::Destroy: registry.DestroyEntity(target); break;
+                case CommandBuffer::CommandType::Add:
+                case CommandBuffer::CommandType::Remove:  cmd.apply(registry, target, cmd.payload); break;
+                case CommandBuffer::CommandType::Create:  break;
+            }
+            ++applied;
+        }
+
+        for (auto& buffer : m_buffers) buffer->Clear();
+        return applied;
+    }
+
+    // Maps a provisional ID from the last playback to the real EntityID.
+    // Real IDs pass through unchanged; unknown provisional IDs map to INVALID_ENTITY.
+    EntityID Resolve(EntityID id) const {
+        if (!IsProvisional(id)) return id;
+        const size_t worker = (id >> 32) & 0x7FFFFFFFu;
+        const size_t local = id & 0xFFFFFFFFu;
+        if (worker >= m_resolved.size() || local >= m_resolved[worker].size()) return INVALID_ENTITY;
+        return m_resolved[worker][local];
+    }
+
+    // Forget the provisional->real mapping from the previous playback.
+    void ClearResolved() {
+        for (auto& slots : m_resolved) slots.clear();
+    }
+
+private:
+    EntityID& ResolvedSlot(EntityID provisional) {
+        return m_resolved[(provisional >> 32) & 0x7FFFFFFFu][provisional & 0xFFFFFFFFu];
+    }
+
+    std::pmr::memory_resource* m_resource;   // playback scratch
+    std::vector<std::unique_ptr<CommandBuffer>> m_buffers;
+    // [worker][local create index]. Outlives playback (Resolve() is called
+    // afterwards), so it is not arena scratch; capacity is kept and reused.
+    std::vector<std::vector<EntityID>> m_resolved;
+};
+
+} // namespace ednms
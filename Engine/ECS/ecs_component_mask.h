@@ -1,10 +1,145 @@
 #pragma once
-#include <bitset>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 
 namespace ednms {
 
-static constexpr size_t MAX_COMPONENTS = 64;
-using ComponentMask = std::bitset<MAX_COMPONENTS>;
+// Component IDs are explicit (see ecs_component_traits.h), so bit indices in
+// a ComponentMask are stable across builds and safe to persist in saves.
+static constexpr size_t MAX_COMPONENTS = 256;
+
+// Fixed-width component bitmask stored as 64-bit words.
+// Matching is a straight word loop over an aligned array, which compilers
+// turn into a couple of SIMD and/compare ops at -O2.
+class alignas(32) ComponentMask {
+public:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t WORD_COUNT = MAX_COMPONENTS / WORD_BITS;
+
+    constexpr ComponentMask() = default;
+
+    constexpr ComponentMask& set(size_t bit) {
+        m_words[bit / WORD_BITS] |= uint64_t{1} << (bit % WORD_BITS);
+        return *this;
+    }
+
+    constexpr ComponentMask& reset(size_t bit) {
+        m_words[bit / WORD_BITS] &= ~(uint64_t{1} << (bit % WORD_BITS));
+        return *this;
+    }
+
+    constexpr ComponentMask& reset() {
+        for (auto& w : m_words) w = 0;
+        return *this;
+    }
+
+    constexpr bool test(size_t bit) const {
+        return (m_words[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1u;
+    }
+
+    constexpr size_t size() const { return MAX_COMPONENTS; }
+
+    size_t count() const {
+        size_t n = 0;
+        for (uint64_t w : m_words) n += PopCount(w);
+        return n;
+    }
+
+    constexpr bool none() const {
+        uint64_t any = 0;
+        for (uint64_t w : m_words) any |= w;
+        return any == 0;
+    }
+
+    constexpr bool any() const { return !none(); }
+
+    // True if every bit in `required` is also set here.
+    constexpr bool Contains(const ComponentMask& required) const {
+        uint64_t missing = 0;
+        for (size_t i = 0; i < WORD_COUNT; ++i) missing |= required.m_words[i] & ~m_words[i];
+        return missing == 0;
+    }
+
+    // True if any bit in `other` is also set here.
+    constexpr bool Intersects(const ComponentMask& other) const {
+        uint64_t common = 0;
+        for (size_t i = 0; i < WORD_COUNT; ++i) common |= m_words[i] & other.m_words[i];
+        return common != 0;
+    }
+
+    // Calls fn(bit) for each set bit in ascending order.
+    template<typename Fn>
+    void ForEachSetBit(Fn&& fn) const {
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            uint64_t w = m_words[i];
+            while (w) {
+                const size_t bit = CountTrailingZeros(w);
+                fn(i * WORD_BITS + bit);
+                w &= w - 1;
+            }
+        }
+    }
+
+    constexpr ComponentMask operator&(const ComponentMask& other) const {
+        ComponentMask r;
+        for (size_t i = 0; i < WORD_COUNT; ++i) r.m_words[i] = m_words[i] & other.m_words[i];
+        return r;
+    }
+
+    constexpr ComponentMask operator|(const ComponentMask& other) const {
+        ComponentMask r;
+        for (size_t i = 0; i < WORD_COUNT; ++i) r.m_words[i] = m_words[i] | other.m_words[i];
+        return r;
+    }
+
+    constexpr ComponentMask& operator&=(const ComponentMask& other) {
+        for (size_t i = 0; i < WORD_COUNT; ++i) m_words[i] &= other.m_words[i];
+        return *this;
+    }
+
+    constexpr ComponentMask& operator|=(const ComponentMask& other) {
+        for (size_t i = 0; i < WORD_COUNT; ++i) m_words[i] |= other.m_words[i];
+        return *this;
+    }
+
+    constexpr bool operator==(const ComponentMask& other) const {
+        uint64_t diff = 0;
+        for (size_t i = 0; i < WORD_COUNT; ++i) diff |= m_words[i] ^ other.m_words[i];
+        return diff == 0;
+    }
+
+    constexpr bool operator!=(const ComponentMask& other) const { return !(*this == other); }
+
+    // Raw words, e.g. for writing EntityRecords.
+    const std::array<uint64_t, WORD_COUNT>& Words() const { return m_words; }
+    uint64_t Word(size_t index) const { return m_words[index]; }
+    void SetWord(size_t index, uint64_t value) { m_words[index] = value; }
+
+private:
+    static size_t PopCount(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(w));
+#else
+        size_t n = 0;
+        for (; w; w &= w - 1) ++n;
+        return n;
+#endif
+    }
+
+    static size_t CountTrailingZeros(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(w));
+#else
+        size_t n = 0;
+        while (!(w & 1u)) { w >>= 1; ++n; }
+        return n;
+#endif
+    }
+
+    std::array<uint64_t, WORD_COUNT> m_words{};
+};
+
+static_assert(MAX_COMPONENTS % ComponentMask::WORD_BITS == 0, "mask must be whole words");
 
 } // namespace ednms
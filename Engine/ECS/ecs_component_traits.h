@@ -0,0 +1,125 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "ecs_component_mask.h"
+
+namespace ednms {
+
+using ComponentTypeID = uint16_t;
+static constexpr ComponentTypeID INVALID_COMPONENT_TYPE = 0xFFFF;
+
+// Every component type must be registered with an explicit, never-reused ID:
+//
+//     EDNMS_COMPONENT(TransformComponent, 0, 1)   // (type, id, version)
+//
+// The ID is the component's bit in ComponentMask and its index in the
+// registry's pool table, so it must stay stable once saves exist.
+template<typename T>
+struct ComponentTraits;   // undefined: unregistered components fail to compile
+
+// Each EDNMS_COMPONENT also claims its ID here, so registering two types
+// with the same ID is a redefinition error in any translation unit that
+// sees both, whether or not they are listed in a ComponentTypeList.
+template<ComponentTypeID Id>
+struct ComponentIdClaim;
+
+#define EDNMS_COMPONENT(Type, Id, Version)                                  \
+    template<>                                                              \
+    struct ComponentIdClaim<(Id)> {                                         \
+        using type = Type;                                                  \
+    };                                                                      \
+    template<>                                                              \
+    struct ComponentTraits<Type> {                                          \
+        static constexpr ComponentTypeID ID = (Id);                         \
+        static constexpr uint32_t VERSION = (Version);                      \
+        static constexpr const char* NAME = #Type;                          \
+        static_assert((Id) < MAX_COMPONENTS, #Type " ID out of range");     \
+    }
+
+// Byte-wise serializer for trivially copyable components. Non-trivial
+// components leave the serializer null until they provide their own.
+using ComponentSerializeFn = void (*)(const void* component, std::vector<uint8_t>& out);
+using ComponentDeserializeFn = bool (*)(void* component, const uint8_t* data, size_t size);
+
+struct ComponentInfo {
+    ComponentTypeID id = INVALID_COMPONENT_TYPE;
+    const char* name = nullptr;
+    uint32_t size = 0;
+    uint32_t alignment = 0;
+    uint32_t version = 0;
+    bool triviallyCopyable = false;
+    ComponentSerializeFn serialize = nullptr;
+    ComponentDeserializeFn deserialize = nullptr;
+
+    constexpr bool IsValid() const { return id != INVALID_COMPONENT_TYPE; }
+};
+
+namespace detail {
+
+template<typename T>
+void SerializeTrivial(const void* component, std::vector<uint8_t>& out) {
+    const auto* bytes = static_cast<const uint8_t*>(component);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+bool DeserializeTrivial(void* component, const uint8_t* data, size_t size) {
+    if (size != sizeof(T)) return false;
+    std::memcpy(component, data, sizeof(T));
+    return true;
+}
+
+} // namespace detail
+
+template<typename T>
+constexpr ComponentTypeID ComponentID() {
+    return ComponentTraits<T>::ID;
+}
+
+template<typename T>
+constexpr ComponentInfo MakeComponentInfo() {
+    using Traits = ComponentTraits<T>;
+    constexpr bool trivial = std::is_trivially_copyable_v<T>;
+    ComponentInfo info;
+    info.id = Traits::ID;
+    info.name = Traits::NAME;
+    info.size = static_cast<uint32_t>(sizeof(T));
+    info.alignment = static_cast<uint32_t>(alignof(T));
+    info.version = Traits::VERSION;
+    info.triviallyCopyable = trivial;
+    if constexpr (trivial) {
+        info.serialize = &detail::SerializeTrivial<T>;
+        info.deserialize = &detail::DeserializeTrivial<T>;
+    }
+    return info;
+}
+
+template<typename... Ts>
+constexpr ComponentMask MakeComponentMask() {
+    ComponentMask mask;
+    (mask.set(ComponentID<Ts>()), ...);
+    return mask;
+}
+
+template<typename... Ts>
+struct ComponentTypeList {};
+
+// Builds an ID-indexed metadata table; fails to compile on duplicate IDs.
+template<typename... Ts>
+constexpr std::array<ComponentInfo, MAX_COMPONENTS> MakeComponentInfoTable(ComponentTypeList<Ts...>) {
+    std::array<ComponentInfo, MAX_COMPONENTS> table{};
+    bool duplicate = false;
+    auto add = [&](const ComponentInfo& info) {
+        if (table[info.id].IsValid()) duplicate = true;
+        table[info.id] = info;
+    };
+    (add(MakeComponentInfo<Ts>()), ...);
+    if (duplicate) throw "duplicate component ID";   // not a constant expression -> compile error
+    return table;
+}
+
+} // namespace ednms
@@ -1,13 +1,40 @@
 #pragma once
 #include <unordered_map>
-#include <any>
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <deque>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include "ecs_types.h"
 #include "ecs_component_mask.h"
+#include "ecs_component_traits.h"
 
 namespace ednms {
 
+// Change detection
+// ----------------
+// Pools opted in with EnableChangeTracking<T>() record added / changed /
+// removed events, so systems can ask "what happened to T since I last ran"
+// instead of scanning the world.
+//
+// Events are stamped with a change version, not the tick. A consumer calls
+// ObserveChanges() at the end of its run and keeps the returned version:
+// every write made so far is stamped at or before it, and every later write
+// (even in the same tick) is stamped strictly after it. Queries return
+// events stamped after `sinceVersion`, so nothing written after a consumer
+// ran is ever lost, and its own writes are not re-reported.
+//
+// A component counts as changed when it is added, overwritten via
+// AddComponent, fetched through the mutable GetComponent, or flagged with
+// MarkChanged. Read-only access goes through the const overloads.
+// The tick (AdvanceTick() once per simulation frame) is kept for reporting
+// only, e.g. GetChangedTick().
+//
+// History is trimmed per pool by the consumer that owns it:
+// TrimChangeHistory<T>(cursor). A pool read by several consumers must be
+// trimmed to the minimum of their cursors.
 class ECSRegistry {
 public:
     EntityID CreateEntity() {
@@ -17,10 +44,16 @@ public:
     }
 
     void DestroyEntity(EntityID id) {
-        m_entityMasks.erase(id);
-        for (auto& pool : m_componentPools) {
-            pool.second.erase(id);
-        }
+        auto maskIt = m_entityMasks.find(id);
+        if (maskIt == m_entityMasks.end()) return;
+        // Only visit the pools this entity actually has components in.
+        maskIt->second.ForEachSetBit([&](size_t typeId) {
+            ComponentPool& pool = *m_componentPools[typeId];
+            if (pool.Erase(id) && pool.trackChanges) {
+                pool.removed.push_back({m_changeVersion, id});
+            }
+        });
+        m_entityMasks.erase(maskIt);
     }
 
     bool HasEntity(EntityID id) const {
@@ -29,39 +62,58 @@ public:
 
     template<typename T>
     void AddComponent(EntityID id, const T& component) {
-        const size_t typeId = GetComponentTypeID<T>();
-        m_componentPools[typeId][id] = component;
+        constexpr size_t typeId = GetComponentTypeID<T>();
+        TypedPool<T>& pool = EnsurePool<T>();
+        auto [it, inserted] = pool.slots.try_emplace(id, component);
+        SlotMeta& meta = it->second.meta;
+        if (inserted) {
+            meta.addedTick = m_currentTick;
+            meta.changedTick = m_currentTick;
+            meta.addedVersion = m_changeVersion;
+            meta.changedVersion = m_changeVersion;
+            if (pool.trackChanges) {
+                pool.added.push_back({m_changeVersion, id});
+                pool.changed.push_back({m_changeVersion, id});
+            }
+        } else {
+            it->second.value = component;
+            Touch(pool, id, meta);
+        }
         m_entityMasks[id].set(typeId);
     }
 
     template<typename T>
     void RemoveComponent(EntityID id) {
-        const size_t typeId = GetComponentTypeID<T>();
-        m_componentPools[typeId].erase(id);
+        constexpr size_t typeId = GetComponentTypeID<T>();
+        ComponentPool* pool = m_componentPools[typeId].get();
+        if (pool && pool->Erase(id) && pool->trackChanges) {
+            pool->removed.push_back({m_changeVersion, id});
+        }
         m_entityMasks[id].reset(typeId);
     }
 
+    // Mutable access; stamps the component as changed on tracked pools.
     template<typename T>
     T* GetComponent(EntityID id) {
-        const size_t typeId = GetComponentTypeID<T>();
-        auto poolIt = m_componentPools.find(typeId);
-        if (poolIt == m_componentPools.end()) return nullptr;
-        auto it = poolIt->second.find(id);
-        return it != poolIt->second.end() ? std::any_cast<T>(&it->second) : nullptr;
+        TypedPool<T>* pool = FindPool<T>();
+        if (!pool) return nullptr;
+        auto it = pool->slots.find(id);
+        if (it == pool->slots.end()) return nullptr;
+        Touch(*pool, id, it->second.meta);
+        return &it->second.value;
     }
 
     template<typename T>
     const T* GetComponent(EntityID id) const {
-        const size_t typeId = GetComponentTypeID<T>();
-        auto poolIt = m_componentPools.find(typeId);
-        if (poolIt == m_componentPools.end()) return nullptr;
-        auto it = poolIt->second.find(id);
-        return it != poolIt->second.end() ? std::any_cast<T>(&it->second) : nullptr;
+        const TypedPool<T>* pool = FindPool<T>();
+        if (!pool) return nullptr;
+        auto it = pool->slots.find(id);
+        return it != pool->slots.end() ? &it->second.value : nullptr;
     }
 
     template<typename T>
     bool HasComponent(EntityID id) const {
-        const size_t typeId = GetComponentTypeID<T>();
+        constexpr size_t typeId = GetComponentTypeID<T>();
         const auto& mask = m_entityMasks.at(id);
         return mask.test(typeId);
     }
@@ -74,29 +126,260 @@ public:
         return m_entityMasks.size();
     }
 
-    // Collect all entities matching a given component mask
-    std::vector<EntityID> GetEntitiesWithMask(const ComponentMask& required) const {
-        std::vector<EntityID> result;
+    // Pre-size storage ahead of a batch of structural changes
+    // (used by CommandBuffer playback).
+    void ReserveEntities(size_t additional) {
+        ReserveMap(m_entityMasks, m_entityMasks.size() + additional);
+    }
+
+    template<typename T>
+    void ReserveComponents(size_t additional) {
+        EnsurePool<T>().Reserve(additional);
+    }
+
+    // Type-erased form; only pools that already exist are grown.
+    void ReserveComponents(ComponentTypeID typeId, size_t additional) {
+        if (ComponentPool* pool = m_componentPools[typeId].get()) pool->Reserve(additional);
+    }
+
+    template<typename... Ts>
+    static constexpr ComponentMask MaskOf() {
+        return MakeComponentMask<Ts...>();
+    }
+
+    // Collect all entities matching a given component mask.
+    // Pass a frame arena as `resource` to keep per-frame queries off the heap.
+    EntityList GetEntitiesWithMask(const ComponentMask& required,
+                                   std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        EntityList result(resource);
         for (const auto& [id, mask] : m_entityMasks) {
-            if ((mask & required) == required) {
+            if (mask.Contains(required)) {
                 result.push_back(id);
             }
         }
         return result;
     }
 
+    // --- Change detection ---
+
+    uint64_t CurrentTick() const { return m_currentTick; }
+    uint64_t AdvanceTick() { return ++m_currentTick; }
+
+    // Close the current change window: returns a version covering every
+    // write so far; writes after this call are stamped strictly later.
+    // Store the result and pass it to the next Get*Since query.
+    uint64_t ObserveChanges() { return m_changeVersion++; }
+
+    // Opt a component type into event logging. Events before this call are not seen.
+    template<typename T>
+    void EnableChangeTracking() {
+        EnsurePool<T>().trackChanges = true;
+    }
+
+    template<typename T>
+    bool IsChangeTracked() const {
+        const ComponentPool* pool = FindPool<T>();
+        return pool && pool->trackChanges;
+    }
+
+    // Flag a component as changed without going through the mutable accessor.
+    template<typename T>
+    void MarkChanged(EntityID id) {
+        TypedPool<T>* pool = FindPool<T>();
+        if (!pool) return;
+        auto it = pool->slots.find(id);
+        if (it != pool->slots.end()) Touch(*pool, id, it->second.meta);
+    }
+
+    // Tick at which T was last added/overwritten/modified on `id` (0 if absent).
+    template<typename T>
+    uint64_t GetChangedTick(EntityID id) const {
+        const TypedPool<T>* pool = FindPool<T>();
+        if (!pool) return 0;
+        auto it = pool->slots.find(id);
+        return it != pool->slots.end() ? it->second.meta.changedTick : 0;
+    }
+
+    // Entities whose T was added or changed after `sinceVersion` and still have it.
+    template<typename T>
+    EntityList GetChangedSince(uint64_t sinceVersion,
+                               std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        EntityList result(resource);
+        if (const ComponentPool* pool = FindPool<T>()) {
+            CollectLive(*pool, pool->changed, sinceVersion, &SlotMeta::changedVersion, result);
+        }
+        return result;
+    }
+
+    // Entities that gained T after `sinceVersion` and still have it.
+    template<typename T>
+    EntityList GetAddedSince(uint64_t sinceVersion,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        EntityList result(resource);
+        if (const ComponentPool* pool = FindPool<T>()) {
+            CollectLive(*pool, pool->added, sinceVersion, &SlotMeta::addedVersion, result);
+        }
+        return result;
+    }
+
+    // Entities that lost T (or were destroyed) after `sinceVersion`.
+    template<typename T>
+    EntityList GetRemovedSince(uint64_t sinceVersion,
+                               std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const {
+        EntityList result(resource);
+        if (const ComponentPool* pool = FindPool<T>()) {
+            for (auto it = pool->removed.rbegin(); it != pool->removed.rend() && it->version > sinceVersion; ++it) {
+                result.push_back(it->entity);
+            }
+            SortUnique(result);
+        }
+        return result;
+    }
+
+    // Drop T's logged events stamped at or before `version`. Pass the oldest
+    // cursor among every consumer of T, never just your own.
+    template<typename T>
+    void TrimChangeHistory(uint64_t version) {
+        if (ComponentPool* pool = FindPool<T>()) {
+            TrimLog(pool->added, version);
+            TrimLog(pool->changed, version);
+            TrimLog(pool->removed, version);
+        }
+    }
+
+    // Trims every pool. Only for a caller that knows the oldest cursor of
+    // all consumers of all tracked types (e.g. a scheduler at a full
+    // barrier); a single system must use TrimChangeHistory<T>.
+    void TrimAllChangeHistory(uint64_t oldestCursor) {
+        for (auto& pool : m_componentPools) {
+            if (!pool) continue;
+            TrimLog(pool->added, oldestCursor);
+            TrimLog(pool->changed, oldestCursor);
+            TrimLog(pool->removed, oldestCursor);
+        }
+    }
+
 private:
+    // unordered_map::reserve rehashes (and reallocates the buckets) even when
+    // the table is already big enough; only grow when it is not.
+    template<typename Map>
+    static void ReserveMap(Map& map, size_t count) {
+        if (static_cast<float>(count) > map.max_load_factor() * static_cast<float>(map.bucket_count())) {
+            map.reserve(count);
+        }
+    }
+
+    struct SlotMeta {
+        uint64_t addedTick = 0;        // reporting only
+        uint64_t changedTick = 0;
+        uint64_t addedVersion = 0;     // change detection
+        uint64_t changedVersion = 0;
+    };
+
+    struct ChangeEvent {
+        uint64_t version;
+        EntityID entity;
+    };
+
+    // Type-erased half of a pool: change logs plus the few operations the
+    // registry performs without knowing T (destroy, reserve, stamp lookup).
+    struct ComponentPool {
+        virtual ~ComponentPool() = default;
+        virtual bool Erase(EntityID id) = 0;
+        virtual void Reserve(size_t additional) = 0;
+        virtual const SlotMeta* FindMeta(EntityID id) const = 0;
+
+        bool trackChanges = false;
+        // Append-only, so each log is sorted by version.
+        std::deque<ChangeEvent> added;
+        std::deque<ChangeEvent> changed;
+        std::deque<ChangeEvent> removed;
+    };
+
+    // Typed storage: component access is a hash lookup returning T* directly,
+    // no std::any / RTTI. Map nodes keep component pointers stable across
+    // inserts into the same pool.
+    template<typename T>
+    struct TypedPool final : ComponentPool {
+        struct Slot {
+            explicit Slot(const T& v) : value(v) {}
+            T value;
+            SlotMeta meta;
+        };
+        std::unordered_map<EntityID, Slot> slots;
+
+        bool Erase(EntityID id) override { return slots.erase(id) > 0; }
+        void Reserve(size_t additional) override { ReserveMap(slots, slots.size() + additional); }
+        const SlotMeta* FindMeta(EntityID id) const override {
+            auto it = slots.find(id);
+            return it != slots.end() ? &it->second.meta : nullptr;
+        }
+    };
+
     EntityID m_nextEntity = 0;
+    uint64_t m_currentTick = 0;
+    uint64_t m_changeVersion = 1;   // 0 = "before anything", a valid initial cursor
     std::unordered_map<EntityID, ComponentMask> m_entityMasks;
-    std::unordered_map<size_t, std::unordered_map<EntityID, std::any>> m_componentPools;
+    // Indexed directly by ComponentTypeID; pools are created on first use.
+    std::array<std::unique_ptr<ComponentPool>, MAX_COMPONENTS> m_componentPools;
 
     template<typename T>
-    static size_t GetComponentTypeID() {
-        static size_t id = s_nextTypeID++;
-        return id;
+    TypedPool<T>& EnsurePool() {
+        auto& pool = m_componentPools[GetComponentTypeID<T>()];
+        if (!pool) pool = std::make_unique<TypedPool<T>>();
+        return static_cast<TypedPool<T>&>(*pool);
+    }
+
+    void Touch(ComponentPool& pool, EntityID id, SlotMeta& slot) {
+        // Log once per change window; repeated touches before the next
+        // ObserveChanges() are indistinguishable to every consumer.
+        if (pool.trackChanges && slot.changedVersion != m_changeVersion) {
+            pool.changed.push_back({m_changeVersion, id});
+        }
+        slot.changedTick = m_currentTick;
+        slot.changedVersion = m_changeVersion;
+    }
+
+    // The pool at ComponentID<T>() is always a TypedPool<T>: IDs are unique per type.
+    template<typename T>
+    TypedPool<T>* FindPool() {
+        return static_cast<TypedPool<T>*>(m_componentPools[GetComponentTypeID<T>()].get());
+    }
+
+    template<typename T>
+    const TypedPool<T>* FindPool() const {
+        return static_cast<const TypedPool<T>*>(m_componentPools[GetComponentTypeID<T>()].get());
     }
 
-    static inline size_t s_nextTypeID = 0;
+    // Walk a log newest-first; an entity is reported only from the event
+    // matching its current slot stamp, and only if it still has the component.
+    static void CollectLive(const ComponentPool& pool, const std::deque<ChangeEvent>& log,
+                            uint64_t sinceVersion, uint64_t SlotMeta::*stamp,
+                            EntityList& out) {
+        for (auto it = log.rbegin(); it != log.rend() && it->version > sinceVersion; ++it) {
+            const SlotMeta* meta = pool.FindMeta(it->entity);
+            if (meta && meta->*stamp == it->version) {
+                out.push_back(it->entity);
+            }
+        }
+        SortUnique(out);
+    }
+
+    // Remove/re-add within one change window can log an entity twice; results are
+    // returned in ascending EntityID order so consumers stay deterministic.
+    static void SortUnique(EntityList& ids) {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+    static void TrimLog(std::deque<ChangeEvent>& log, uint64_t version) {
+        while (!log.empty() && log.front().version <= version) log.pop_front();
+    }
+
+    template<typename T>
+    static constexpr size_t GetComponentTypeID() {
+        return ComponentID<T>();
+    }
 };
 
 } // namespace ednms
@@ -1,5 +1,7 @@
 #pragma once
 #include <cstdint>
+#include <memory_resource>
+#include <vector>
 
 namespace ednms {
 
@@ -10,4 +12,8 @@ using ResourceID = uint32_t;
 using BlueprintID = uint32_t;
 using FactionID = uint32_t;
 
+// Entity lists returned by registry queries; allocator-aware so callers can
+// hand in a per-frame arena.
+using EntityList = std::pmr::vector<EntityID>;
+
 } // namespace ednms
@@ -0,0 +1,127 @@
+#include "lz_codec.h"
+#include <array>
+#include <cstring>
+
+namespace ednms {
+namespace lz {
+
+namespace {
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_OFFSET = 0xFFFF;
+constexpr size_t HASH_BITS = 14;
+// The last bytes are always emitted as literals so the decoder's match copy
+// never needs to look past the end of a sequence.
+constexpr size_t LAST_LITERALS = 5;
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t Hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount,
+                  size_t offset, size_t matchLength) {
+    const size_t litNibble = literalCount < 15 ? literalCount : 15;
+    const size_t matchExtra = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    const size_t matchNibble = matchExtra < 15 ? matchExtra : 15;
+    out.push_back(static_cast<uint8_t>((litNibble << 4) | matchNibble));
+    if (litNibble == 15) WriteLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0) return;   // final literal-only sequence
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchNibble == 15) WriteLength(out, matchExtra - 15);
+}
+
+bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+void Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+    out.reserve(out.size() + CompressBound(size));
+    std::array<uint32_t, size_t{1} << HASH_BITS> table{};   // position + 1, 0 = empty
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    if (size > MIN_MATCH + LAST_LITERALS) {
+        const size_t matchLimit = size - LAST_LITERALS;
+        while (pos + MIN_MATCH <= matchLimit) {
+            const uint32_t seq = Read32(src + pos);
+            const uint32_t h = Hash(seq);
+            const size_t candidate = table[h];
+            table[h] = static_cast<uint32_t>(pos + 1);
+
+            if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET
+                    || Read32(src + candidate - 1) != seq) {
+                ++pos;
+                continue;
+            }
+
+            const size_t matchPos = candidate - 1;
+            size_t length = MIN_MATCH;
+            while (pos + length < matchLimit && src[matchPos + length] == src[pos + length]) ++length;
+
+            EmitSequence(out, src + anchor, pos - anchor, pos - matchPos, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    EmitSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* ip = src;
+    const uint8_t* const ipEnd = src + srcSize;
+    size_t op = 0;
+
+    while (ip < ipEnd) {
+        const uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !ReadLength(ip, ipEnd, literals)) return false;
+        if (literals > static_cast<size_t>(ipEnd - ip) || literals > dstSize - op) return false;
+        if (literals > 0) std::memcpy(dst + op, ip, literals);   // dst may be null for empty output
+        ip += literals;
+        op += literals;
+
+        if (ip == ipEnd) break;   // final sequence has no match
+
+        if (ipEnd - ip < 2) return false;
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        size_t length = token & 0x0F;
+        if (length == 15 && !ReadLength(ip, ipEnd, length)) return false;
+        length += MIN_MATCH;
+
+        if (offset == 0 || offset > op || length > dstSize - op) return false;
+        // Byte-wise copy: overlapping matches (offset < length) replicate runs.
+        const uint8_t* match = dst + op - offset;
+        for (size_t i = 0; i < length; ++i) dst[op + i] = match[i];
+        op += length;
+    }
+    return op == dstSize;
+}
+
+} // namespace lz
+} // namespace ednms
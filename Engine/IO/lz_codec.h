@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ednms {
+
+// Small LZ77 block codec (LZ4-style sequences) for chunk blobs.
+// Favours speed over ratio: one pass, 4-byte hash matches, no entropy stage.
+//
+// Sequence format:
+//   token    : hi nibble = literal length, lo nibble = match length - 4
+//              (15 means "more length bytes follow", each 255 adds and continues)
+//   literals : raw bytes
+//   offset   : uint16 little-endian distance back into the output
+// The final sequence carries literals only and has no offset.
+namespace lz {
+
+// Worst-case compressed size for `rawSize` input bytes.
+inline size_t CompressBound(size_t rawSize) {
+    return rawSize + rawSize / 255 + 16;
+}
+
+// Appends the compressed form of [src, src + size) to `out`.
+void Compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+// Decodes exactly `dstSize` bytes into `dst`. Returns false on malformed input.
+bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+} // namespace lz
+} // namespace ednms
@@ -0,0 +1,387 @@
+#include "region_file.h"
+#include "lz_codec.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace ednms {
+
+namespace {
+
+constexpr uint64_t TABLE_OFFSET = sizeof(RegionFileHeader);
+constexpr uint64_t TABLE_BYTES = uint64_t{REGION_CHUNK_COUNT} * sizeof(RegionEntry);
+// Header + table occupy the first sectors; blobs start after them.
+constexpr uint32_t FIRST_DATA_SECTOR =
+    static_cast<uint32_t>((TABLE_OFFSET + TABLE_BYTES + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+
+RegionFileHeader MakeHeader(const RegionCoord& region) {
+    RegionFileHeader header;
+    header.magic = REGION_MAGIC;
+    header.version = REGION_VERSION;
+    header.sectorSize = REGION_SECTOR_SIZE;
+    header.chunksPerAxis = REGION_CHUNKS_PER_AXIS;
+    header.regionX = region.x;
+    header.regionY = region.y;
+    header.regionZ = region.z;
+    return header;
+}
+
+void WritePadding(std::ostream& out, size_t bytes) {
+    static const char zeros[REGION_SECTOR_SIZE] = {};
+    while (bytes > 0) {
+        const size_t n = std::min<size_t>(bytes, sizeof(zeros));
+        out.write(zeros, static_cast<std::streamsize>(n));
+        bytes -= n;
+    }
+}
+
+} // namespace
+
+std::string RegionFileName(const RegionCoord& region) {
+    return "r." + std::to_string(region.x) + "." + std::to_string(region.y) + "."
+        + std::to_string(region.z) + ".region";
+}
+
+// --- RegionFile ---
+
+bool RegionFile::Open(const std::string& path, const RegionCoord& region) {
+    Close();
+    m_path = path;
+    m_region = region;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec) && !CreateEmpty()) return false;
+
+    m_file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!m_file.is_open()) return false;
+    if (!LoadTable()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void RegionFile::Close() {
+    if (m_file.is_open()) m_file.close();
+    m_file.clear();
+    m_entries.clear();
+    m_sectorUsed.clear();
+}
+
+bool RegionFile::CreateEmpty() {
+    std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    const RegionFileHeader header = MakeHeader(m_region);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WritePadding(out, uint64_t{FIRST_DATA_SECTOR} * REGION_SECTOR_SIZE - TABLE_OFFSET);
+    return static_cast<bool>(out);
+}
+
+bool RegionFile::LoadTable() {
+    RegionFileHeader header;
+    m_file.seekg(0);
+    m_file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!m_file || header.magic != REGION_MAGIC || header.version != REGION_VERSION
+            || header.sectorSize != REGION_SECTOR_SIZE || header.chunksPerAxis != REGION_CHUNKS_PER_AXIS
+            || header.regionX != m_region.x || header.regionY != m_region.y || header.regionZ != m_region.z) {
+        return false;
+    }
+
+    m_entries.resize(REGION_CHUNK_COUNT);
+    m_file.read(reinterpret_cast<char*>(m_entries.data()), static_cast<std::streamsize>(TABLE_BYTES));
+    if (!m_file) return false;
+
+    m_file.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(m_file.tellg());
+    const auto totalSectors = static_cast<uint32_t>(fileSize / REGION_SECTOR_SIZE);
+    if (totalSectors < FIRST_DATA_SECTOR) return false;
+
+    m_sectorUsed.assign(totalSectors, false);
+    MarkSectors(0, FIRST_DATA_SECTOR, true);
+    m_droppedEntries = 0;
+    for (uint32_t index = 0; index < REGION_CHUNK_COUNT; ++index) {
+        RegionEntry& entry = m_entries[index];
+        if (entry.sector == 0) continue;
+        if (!EntryValid(entry, totalSectors)) {
+            entry = RegionEntry{};
+            ++m_droppedEntries;
+            if (!WriteEntry(index)) return false;
+            continue;
+        }
+        MarkSectors(entry.sector, std::max<uint32_t>(SectorsFor(entry.storedSize), 1), true);
+    }
+    return true;
+}
+
+bool RegionFile::EntryValid(const RegionEntry& entry, uint32_t totalSectors) const {
+    if (entry.rawSize > REGION_MAX_CHUNK_BYTES) return false;
+    switch (entry.codec) {
+        case BlobCodec::Raw:
+            if (entry.storedSize != entry.rawSize) return false;
+            break;
+        case BlobCodec::LZ:
+            if (entry.storedSize == 0 || entry.storedSize > lz::CompressBound(entry.rawSize)) return false;
+            break;
+        default:
+            return false;
+    }
+    const uint32_t count = std::max<uint32_t>(SectorsFor(entry.storedSize), 1);
+    if (entry.sector < FIRST_DATA_SECTOR || uint64_t{entry.sector} + count > totalSectors) return false;
+    // First claimant wins; a later entry overlapping it is corrupt.
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_sectorUsed[entry.sector + i]) return false;
+    }
+    return true;
+}
+
+bool RegionFile::Contains(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const {
+    return IsOpen() && RegionCoordFor(chunkX, chunkY, chunkZ) == m_region;
+}
+
+bool RegionFile::HasChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const {
+    return Contains(chunkX, chunkY, chunkZ)
+        && m_entries[RegionLocalIndex(chunkX, chunkY, chunkZ)].sector != 0;
+}
+
+bool RegionFile::ReadChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, std::vector<uint8_t>& out) {
+    if (!Contains(chunkX, chunkY, chunkZ)) return false;
+    const RegionEntry& entry = m_entries[RegionLocalIndex(chunkX, chunkY, chunkZ)];
+    // Sizes were validated on load, so the resizes below are bounded.
+    if (entry.sector == 0) return false;
+
+    // Single seek + single read of the stored blob.
+    const bool raw = entry.codec == BlobCodec::Raw;
+    std::vector<uint8_t>& target = raw ? out : m_scratch;
+    target.resize(entry.storedSize);
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(uint64_t{entry.sector} * REGION_SECTOR_SIZE));
+    m_file.read(reinterpret_cast<char*>(target.data()), static_cast<std::streamsize>(entry.storedSize));
+    if (!m_file) return false;
+
+    if (raw) return true;
+    out.resize(entry.rawSize);
+    return lz::Decompress(m_scratch.data(), m_scratch.size(), out.data(), out.size());
+}
+
+bool RegionFile::WriteChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, const uint8_t* data, size_t size) {
+    if (!Contains(chunkX, chunkY, chunkZ) || size > REGION_MAX_CHUNK_BYTES) return false;
+    const uint32_t index = RegionLocalIndex(chunkX, chunkY, chunkZ);
+    RegionEntry& entry = m_entries[index];
+
+    // Keep the compressed form only when it actually saves space.
+    m_scratch.clear();
+    lz::Compress(data, size, m_scratch);
+    const bool compressed = m_scratch.size() < size;
+    const uint8_t* blob = compressed ? m_scratch.data() : data;
+    const size_t blobSize = compressed ? m_scratch.size() : size;
+
+    // Never overwrite the live blob: write to new sectors, switch the entry,
+    // then release the old sectors. A failed write or a process crash at any
+    // point leaves the table pointing at a complete blob. Nothing is fsync'd,
+    // so after an OS crash or power loss the OS may have persisted the entry
+    // but not the blob.
+    const uint32_t needed = std::max<uint32_t>(SectorsFor(blobSize), 1);
+    const uint32_t sector = AllocateSectors(needed);
+    if (!WriteBlob(sector, blob, blobSize)) {
+        MarkSectors(sector, needed, false);
+        return false;
+    }
+
+    const RegionEntry previous = entry;
+    entry.sector = sector;
+    entry.storedSize = static_cast<uint32_t>(blobSize);
+    entry.rawSize = static_cast<uint32_t>(size);
+    entry.codec = compressed ? BlobCodec::LZ : BlobCodec::Raw;
+    if (!WriteEntry(index)) {
+        entry = previous;
+        MarkSectors(sector, needed, false);
+        return false;
+    }
+    if (previous.sector != 0) {
+        MarkSectors(previous.sector, std::max<uint32_t>(SectorsFor(previous.storedSize), 1), false);
+    }
+    return true;
+}
+
+bool RegionFile::EraseChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ) {
+    if (!Contains(chunkX, chunkY, chunkZ)) return false;
+    const uint32_t index = RegionLocalIndex(chunkX, chunkY, chunkZ);
+    RegionEntry& entry = m_entries[index];
+    if (entry.sector == 0) return false;
+    MarkSectors(entry.sector, std::max<uint32_t>(SectorsFor(entry.storedSize), 1), false);
+    entry = RegionEntry{};
+    return WriteEntry(index);
+}
+
+bool RegionFile::WriteEntry(uint32_t index) {
+    m_file.clear();
+    m_file.seekp(static_cast<std::streamoff>(TABLE_OFFSET + uint64_t{index} * sizeof(RegionEntry)));
+    m_file.write(reinterpret_cast<const char*>(&m_entries[index]), sizeof(RegionEntry));
+    m_file.flush();
+    return static_cast<bool>(m_file);
+}
+
+bool RegionFile::WriteBlob(uint32_t sector, const uint8_t* data, size_t size) {
+    m_file.clear();
+    m_file.seekp(static_cast<std::streamoff>(uint64_t{sector} * REGION_SECTOR_SIZE));
+    m_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    const size_t padded = std::max<size_t>(SectorsFor(size), 1) * REGION_SECTOR_SIZE;
+    WritePadding(m_file, padded - size);
+    return static_cast<bool>(m_file);
+}
+
+uint32_t RegionFile::AllocateSectors(uint32_t count) {
+    // First fit among holes; a free run touching the end of file is extended.
+    uint32_t runStart = 0;
+    uint32_t runLength = 0;
+    const auto total = static_cast<uint32_t>(m_sectorUsed.size());
+    for (uint32_t i = FIRST_DATA_SECTOR; i < total; ++i) {
+        if (m_sectorUsed[i]) {
+            runLength = 0;
+            continue;
+        }
+        if (runLength == 0) runStart = i;
+        if (++runLength == count) {
+            MarkSectors(runStart, count, true);
+            return runStart;
+        }
+    }
+    const uint32_t start = runLength > 0 ? runStart : total;
+    m_sectorUsed.resize(uint64_t{start} + count, false);
+    MarkSectors(start, count, true);
+    return start;
+}
+
+void RegionFile::MarkSectors(uint32_t first, uint32_t count, bool used) {
+    for (uint32_t i = 0; i < count; ++i) m_sectorUsed[first + i] = used;
+}
+
+bool RegionFile::Compact() {
+    if (!IsOpen()) return false;
+
+    const std::string tmpPath = m_path + ".compact";
+    std::error_code ec;
+    if (!WriteCompacted(tmpPath)) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    const std::string path = m_path;
+    const RegionCoord region = m_region;
+    Close();
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        // The original is untouched; keep serving it.
+        std::filesystem::remove(tmpPath, ec);
+        Open(path, region);
+        return false;
+    }
+    return Open(path, region);
+}
+
+bool RegionFile::WriteCompacted(const std::string& tmpPath) {
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    // Assign new sectors in local-index order so neighbouring chunks stay adjacent.
+    std::vector<RegionEntry> packed = m_entries;
+    uint32_t next = FIRST_DATA_SECTOR;
+    for (RegionEntry& entry : packed) {
+        if (entry.sector == 0) continue;
+        entry.sector = next;
+        next += std::max<uint32_t>(SectorsFor(entry.storedSize), 1);
+    }
+
+    const RegionFileHeader header = MakeHeader(m_region);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(TABLE_BYTES));
+    WritePadding(out, uint64_t{FIRST_DATA_SECTOR} * REGION_SECTOR_SIZE - TABLE_OFFSET - TABLE_BYTES);
+
+    for (const RegionEntry& entry : m_entries) {
+        if (entry.sector == 0) continue;
+        m_scratch.resize(entry.storedSize);
+        m_file.clear();
+        m_file.seekg(static_cast<std::streamoff>(uint64_t{entry.sector} * REGION_SECTOR_SIZE));
+        m_file.read(reinterpret_cast<char*>(m_scratch.data()), static_cast<std::streamsize>(entry.storedSize));
+        if (!m_file) return false;
+        out.write(reinterpret_cast<const char*>(m_scratch.data()), static_cast<std::streamsize>(entry.storedSize));
+        const size_t padded = std::max<size_t>(SectorsFor(entry.storedSize), 1) * REGION_SECTOR_SIZE;
+        WritePadding(out, padded - entry.storedSize);
+    }
+    out.close();
+    return static_cast<bool>(out);
+}
+
+RegionStats RegionFile::Stats() const {
+    RegionStats stats;
+    stats.totalSectors = static_cast<uint32_t>(m_sectorUsed.size());
+    for (const RegionEntry& entry : m_entries) {
+        if (entry.sector == 0) continue;
+        ++stats.chunkCount;
+        stats.usedSectors += std::max<uint32_t>(SectorsFor(entry.storedSize), 1);
+        stats.rawBytes += entry.rawSize;
+        stats.storedBytes += entry.storedSize;
+    }
+    stats.droppedEntries = m_droppedEntries;
+    for (uint32_t i = FIRST_DATA_SECTOR; i < stats.totalSectors; ++i) {
+        if (!m_sectorUsed[i]) ++stats.freeSectors;
+    }
+    return stats;
+}
+
+// --- RegionStore ---
+
+RegionFile* RegionStore::GetRegion(const RegionCoord& region, bool create) {
+    auto it = m_regions.find(region);
+    if (it != m_regions.end()) {
+        if (it->second.file->IsOpen()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+            return it->second.file.get();
+        }
+        // Closed by a failed Compact(); forget it and reopen from disk.
+        m_lru.erase(it->second.lru);
+        m_regions.erase(it);
+    }
+
+    const std::filesystem::path path = std::filesystem::path(m_directory) / RegionFileName(region);
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        if (!create) return nullptr;
+        std::filesystem::create_directories(m_directory, ec);
+    }
+
+    auto file = std::make_unique<RegionFile>();
+    if (!file->Open(path.string(), region)) return nullptr;
+
+    // Every write is flushed as it happens, so closing a region loses nothing.
+    while (m_regions.size() >= m_maxOpenRegions) {
+        m_regions.erase(m_lru.back());
+        m_lru.pop_back();
+    }
+    RegionFile* raw = file.get();
+    m_lru.push_front(region);
+    m_regions.emplace(region, OpenRegion{std::move(file), m_lru.begin()});
+    return raw;
+}
+
+bool RegionStore::ReadChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, std::vector<uint8_t>& out) {
+    RegionFile* file = GetRegion(RegionCoordFor(chunkX, chunkY, chunkZ), false);
+    return file && file->ReadChunk(chunkX, chunkY, chunkZ, out);
+}
+
+bool RegionStore::WriteChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, const uint8_t* data, size_t size) {
+    RegionFile* file = GetRegion(RegionCoordFor(chunkX, chunkY, chunkZ), true);
+    return file && file->WriteChunk(chunkX, chunkY, chunkZ, data, size);
+}
+
+bool RegionStore::EraseChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ) {
+    RegionFile* file = GetRegion(RegionCoordFor(chunkX, chunkY, chunkZ), false);
+    return file && file->EraseChunk(chunkX, chunkY, chunkZ);
+}
+
+bool RegionStore::CompactAll() {
+    bool ok = true;
+    for (auto& [coord, open] : m_regions) ok = open.file->Compact() && ok;
+    return ok;
+}
+
+} // namespace ednms
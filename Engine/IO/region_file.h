@@ -0,0 +1,222 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ednms {
+
+// Region pack files
+// -----------------
+// Instead of one chunk_NNNN.bin per chunk, a region file packs a cube of
+// REGION_CHUNKS_PER_AXIS^3 chunks:
+//
+//   [RegionFileHeader]            32 bytes
+//   [RegionEntry x 32768]         offset table, indexed by local chunk index
+//   (padding to a sector)
+//   [blob][pad] [blob][pad] ...   sector-aligned, individually LZ-compressed
+//
+// The offset table is loaded on Open(), so reading a chunk is one seek and
+// one read. A rewrite always goes to freshly allocated sectors and the
+// table entry is switched over only after the blob has been written, so the
+// old copy stays intact until then and a process crash never leaves the
+// table pointing at a partial blob. Writes are flushed but not fsync'd, so
+// this does not cover OS crashes or power loss. Freed sectors are reused
+// first-fit and Compact() reclaims the rest.
+
+static constexpr uint32_t REGION_MAGIC = 0x4E474552;   // "REGN"
+static constexpr uint32_t REGION_VERSION = 1;
+static constexpr int32_t REGION_CHUNKS_PER_AXIS = 32;
+static constexpr uint32_t REGION_CHUNK_COUNT =
+    REGION_CHUNKS_PER_AXIS * REGION_CHUNKS_PER_AXIS * REGION_CHUNKS_PER_AXIS;
+static constexpr uint32_t REGION_SECTOR_SIZE = 4096;
+// Upper bound on one chunk's raw size; larger writes are refused and table
+// entries claiming more are treated as corrupt.
+static constexpr uint32_t REGION_MAX_CHUNK_BYTES = 16u << 20;
+
+enum class BlobCodec : uint16_t {
+    Raw = 0,
+    LZ = 1
+};
+
+struct RegionFileHeader {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t sectorSize = 0;
+    uint32_t chunksPerAxis = 0;
+    int32_t regionX = 0;
+    int32_t regionY = 0;
+    int32_t regionZ = 0;
+    uint32_t reserved = 0;
+};
+
+struct RegionEntry {
+    uint32_t sector = 0;        // 0 = chunk not present (sector 0 holds the header)
+    uint32_t storedSize = 0;    // bytes on disk
+    uint32_t rawSize = 0;       // bytes after decompression
+    BlobCodec codec = BlobCodec::Raw;
+    uint16_t reserved = 0;
+};
+
+static_assert(sizeof(RegionFileHeader) == 32, "RegionFileHeader is written verbatim");
+static_assert(sizeof(RegionEntry) == 16, "RegionEntry is written verbatim");
+
+struct RegionCoord {
+    int32_t x = 0;
+    int32_t y = 0;
+    int32_t z = 0;
+
+    bool operator==(const RegionCoord& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+struct RegionStats {
+    uint32_t chunkCount = 0;
+    uint32_t usedSectors = 0;
+    uint32_t freeSectors = 0;     // holes inside the file, reclaimable by Compact()
+    uint32_t totalSectors = 0;
+    uint32_t droppedEntries = 0;  // corrupt table entries discarded on Open()
+    uint64_t rawBytes = 0;
+    uint64_t storedBytes = 0;
+};
+
+// Chunk -> region addressing. Floor division so negative chunks map correctly.
+inline RegionCoord RegionCoordFor(int32_t chunkX, int32_t chunkY, int32_t chunkZ) {
+    auto floorDiv = [](int32_t v) {
+        return v >= 0 ? v / REGION_CHUNKS_PER_AXIS
+                      : -((-v + REGION_CHUNKS_PER_AXIS - 1) / REGION_CHUNKS_PER_AXIS);
+    };
+    return {floorDiv(chunkX), floorDiv(chunkY), floorDiv(chunkZ)};
+}
+
+inline uint32_t RegionLocalIndex(int32_t chunkX, int32_t chunkY, int32_t chunkZ) {
+    auto local = [](int32_t v) {
+        const int32_t m = v % REGION_CHUNKS_PER_AXIS;
+        return static_cast<uint32_t>(m < 0 ? m + REGION_CHUNKS_PER_AXIS : m);
+    };
+    const uint32_t n = REGION_CHUNKS_PER_AXIS;
+    return local(chunkX) + local(chunkY) * n + local(chunkZ) * n * n;
+}
+
+// "r.<x>.<y>.<z>.region"
+std::string RegionFileName(const RegionCoord& region);
+
+class RegionFile {
+public:
+    RegionFile() = default;
+    ~RegionFile() { Close(); }
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    // Opens an existing region file or creates an empty one.
+    // Fails if an existing file has the wrong magic/version or region coord.
+    // Table entries with an unknown codec, impossible sizes, out-of-file
+    // sectors or sectors already claimed by another entry are dropped (and
+    // cleared on disk) so the rest of the region stays readable.
+    bool Open(const std::string& path, const RegionCoord& region);
+    void Close();
+    bool IsOpen() const { return m_file.is_open(); }
+
+    // Chunk coordinates are world chunk coordinates; they must fall in this region.
+    bool HasChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const;
+    bool ReadChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, std::vector<uint8_t>& out);
+    bool WriteChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, const uint8_t* data, size_t size);
+    bool EraseChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ);
+
+    // Works with any coordinate type exposing x/y/z (e.g. ChunkCoord).
+    template<typename Coord>
+    bool ReadChunk(const Coord& c, std::vector<uint8_t>& out) { return ReadChunk(c.x, c.y, c.z, out); }
+    template<typename Coord>
+    bool WriteChunk(const Coord& c, const std::vector<uint8_t>& data) {
+        return WriteChunk(c.x, c.y, c.z, data.data(), data.size());
+    }
+
+    // Rewrites the file with all blobs packed back to back, dropping free sectors.
+    // Goes through "<path>.compact" + rename; on failure the temp file is
+    // removed and the original stays open when possible.
+    bool Compact();
+
+    RegionStats Stats() const;
+    const RegionCoord& Region() const { return m_region; }
+
+private:
+    bool Contains(int32_t chunkX, int32_t chunkY, int32_t chunkZ) const;
+    bool CreateEmpty();
+    bool LoadTable();
+    bool EntryValid(const RegionEntry& entry, uint32_t totalSectors) const;
+    bool WriteEntry(uint32_t index);
+    uint32_t AllocateSectors(uint32_t count);
+    void MarkSectors(uint32_t first, uint32_t count, bool used);
+    bool WriteBlob(uint32_t sector, const uint8_t* data, size_t size);
+    bool WriteCompacted(const std::string& tmpPath);
+
+    static uint32_t SectorsFor(size_t bytes) {
+        return static_cast<uint32_t>((bytes + REGION_SECTOR_SIZE - 1) / REGION_SECTOR_SIZE);
+    }
+
+    std::string m_path;
+    RegionCoord m_region;
+    std::fstream m_file;
+    std::vector<RegionEntry> m_entries;
+    std::vector<bool> m_sectorUsed;   // one flag per sector in the file
+    std::vector<uint8_t> m_scratch;   // compression / read staging
+    uint32_t m_droppedEntries = 0;
+};
+
+// Directory of region files. At most maxOpenRegions stay open; touching
+// another region closes the least recently used one.
+class RegionStore {
+public:
+    static constexpr size_t DEFAULT_MAX_OPEN_REGIONS = 64;
+
+    explicit RegionStore(std::string directory, size_t maxOpenRegions = DEFAULT_MAX_OPEN_REGIONS)
+        : m_directory(std::move(directory)), m_maxOpenRegions(std::max<size_t>(maxOpenRegions, 1)) {}
+
+    bool ReadChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, std::vector<uint8_t>& out);
+    bool WriteChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ, const uint8_t* data, size_t size);
+    bool EraseChunk(int32_t chunkX, int32_t chunkY, int32_t chunkZ);
+
+    template<typename Coord>
+    bool ReadChunk(const Coord& c, std::vector<uint8_t>& out) { return ReadChunk(c.x, c.y, c.z, out); }
+    template<typename Coord>
+    bool WriteChunk(const Coord& c, const std::vector<uint8_t>& data) {
+        return WriteChunk(c.x, c.y, c.z, data.data(), data.size());
+    }
+
+    // Compacts every open region file.
+    bool CompactAll();
+    size_t OpenRegionCount() const { return m_regions.size(); }
+    size_t MaxOpenRegions() const { return m_maxOpenRegions; }
+
+private:
+    struct RegionCoordHash {
+        size_t operator()(const RegionCoord& r) const {
+            uint64_t h = static_cast<uint32_t>(r.x);
+            h = h * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(r.y);
+            h = h * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(r.z);
+            return static_cast<size_t>(h ^ (h >> 32));
+        }
+    };
+
+    struct OpenRegion {
+        std::unique_ptr<RegionFile> file;
+        std::list<RegionCoord>::iterator lru;
+    };
+
+    RegionFile* GetRegion(const RegionCoord& region, bool create);
+
+    std::string m_directory;
+    size_t m_maxOpenRegions;
+    std::unordered_map<RegionCoord, OpenRegion, RegionCoordHash> m_regions;
+    std::list<RegionCoord> m_lru;   // front = most recently used
+};
+
+} // namespace ednms
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace ednms {
+
+// Per-thread allocation counters. Reset at the start of a frame and read at
+// the end to see what a tick cost. Heap counts are only populated when the
+// executable is built with EDNMS_COUNT_HEAP_ALLOCATIONS (see HeapHooks.cpp).
+struct AllocationCounters {
+    uint64_t heapAllocations = 0;
+    uint64_t heapBytes = 0;
+    uint64_t arenaAllocations = 0;
+    uint64_t arenaBytes = 0;
+    uint64_t arenaOverflows = 0;   // arena had to grow from its upstream
+    uint64_t poolAllocations = 0;
+};
+
+AllocationCounters& ThreadAllocationCounters();
+
+inline void ResetThreadAllocationCounters() {
+    ThreadAllocationCounters() = AllocationCounters{};
+}
+
+// True when the global operator new replacement is linked in.
+bool HeapAllocationCountingEnabled();
+
+} // namespace ednms
@@ -0,0 +1,93 @@
+#include "FrameArena.h"
+#include "AllocationCounters.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace ednms {
+
+namespace {
+
+size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+FrameArena::FrameArena(size_t blockSize, std::pmr::memory_resource* upstream)
+    : m_upstream(upstream), m_blockSize(std::max<size_t>(blockSize, 64)) {}
+
+FrameArena::~FrameArena() {
+    for (const Block& block : m_blocks) {
+        m_upstream->deallocate(block.data, block.size, alignof(std::max_align_t));
+    }
+}
+
+void FrameArena::Reset() {
+    m_current = 0;
+    m_offset = 0;
+    m_bytesUsed = 0;
+}
+
+size_t FrameArena::Capacity() const {
+    size_t total = 0;
+    for (const Block& block : m_blocks) total += block.size;
+    return total;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    AllocationCounters& counters = ThreadAllocationCounters();
+    ++counters.arenaAllocations;
+    counters.arenaBytes += bytes;
+
+    // Try the current block, then any retained blocks from earlier frames.
+    while (m_current < m_blocks.size()) {
+        Block& block = m_blocks[m_current];
+        const auto base = reinterpret_cast<uintptr_t>(block.data);
+        const size_t offset = AlignUp(base + m_offset, alignment) - base;
+        if (offset + bytes <= block.size) {
+            m_offset = offset + bytes;
+            m_bytesUsed += bytes;
+            m_highWater = std::max(m_highWater, m_bytesUsed);
+            return block.data + offset;
+        }
+        ++m_current;
+        m_offset = 0;
+    }
+
+    // Out of retained blocks: grow from upstream.
+    ++counters.arenaOverflows;
+    const size_t size = std::max(m_blockSize, bytes + alignment);
+    Block block;
+    block.data = static_cast<std::byte*>(m_upstream->allocate(size, alignof(std::max_align_t)));
+    block.size = size;
+    m_blocks.push_back(block);
+    m_current = m_blocks.size() - 1;
+
+    const auto base = reinterpret_cast<uintptr_t>(block.data);
+    const size_t offset = AlignUp(base, alignment) - base;
+    m_offset = offset + bytes;
+    m_bytesUsed += bytes;
+    m_highWater = std::max(m_highWater, m_bytesUsed);
+    return block.data + offset;
+}
+
+FrameArena& ThreadFrameArena() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+AllocationCounters& ThreadAllocationCounters() {
+    thread_local AllocationCounters counters;
+    return counters;
+}
+
+namespace detail {
+    // Set by HeapHooks.cpp's static initializer when it is linked in.
+    bool g_heapHooksInstalled = false;
+} // namespace detail
+
+bool HeapAllocationCountingEnabled() {
+    return detail::g_heapHooksInstalled;
+}
+
+} // namespace ednms
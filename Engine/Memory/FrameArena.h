@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace ednms {
+
+// Linear (bump) allocator for per-frame transient data.
+// Deallocation is a no-op; Reset() at the end of the tick rewinds the whole
+// arena. Blocks are retained across resets, so once the arena has grown to
+// the frame's high-water mark it stops touching the upstream heap.
+// Use through std::pmr containers: std::pmr::vector<T> v(&arena);
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 256 * 1024;
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Invalidates everything allocated since the last Reset().
+    void Reset();
+
+    size_t BytesUsed() const { return m_bytesUsed; }
+    size_t HighWaterMark() const { return m_highWater; }
+    size_t Capacity() const;
+    size_t BlockCount() const { return m_blocks.size(); }
+
+private:
+    struct Block {
+        std::byte* data = nullptr;
+        size_t size = 0;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream;
+    size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    size_t m_current = 0;    // index of the block being bumped
+    size_t m_offset = 0;     // bump offset within m_blocks[m_current]
+    size_t m_bytesUsed = 0;
+    size_t m_highWater = 0;
+};
+
+// The calling thread's frame arena. Reset it once per tick on that thread.
+FrameArena& ThreadFrameArena();
+
+template<typename T>
+using FrameVector = std::pmr::vector<T>;
+
+} // namespace ednms
@@ -0,0 +1,70 @@
+// Global operator new/delete replacement that feeds AllocationCounters.
+// Compiled directly into executables (not the Engine library) when
+// EDNMS_COUNT_HEAP_ALLOCATIONS is enabled, so a test can assert that a
+// steady-state tick performs zero heap allocations.
+#include "AllocationCounters.h"
+#include <cstdlib>
+#include <new>
+
+namespace ednms {
+namespace detail {
+    extern bool g_heapHooksInstalled;
+    static const bool s_heapHooksRegistered = (g_heapHooksInstalled = true);
+} // namespace detail
+} // namespace ednms
+
+namespace {
+
+void NoteAllocation(std::size_t size) {
+    ednms::AllocationCounters& counters = ednms::ThreadAllocationCounters();
+    ++counters.heapAllocations;
+    counters.heapBytes += size;
+}
+
+void* AllocateAligned(std::size_t size, std::size_t alignment) {
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc requires size to be a multiple of the alignment.
+    const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+}
+
+void FreeAligned(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    NoteAllocation(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    NoteAllocation(size);
+    if (void* ptr = AllocateAligned(size, static_cast<std::size_t>(alignment))) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    FreeAligned(ptr);
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include "AllocationCounters.h"
+
+namespace ednms {
+
+// Fixed-size object pool for short-lived objects (projectiles, debris,
+// transient work items). Storage is carved out in blocks of BlockSize
+// objects and recycled through an intrusive free list; blocks are only
+// released when the pool is destroyed.
+template<typename T, size_t BlockSize = 256>
+class ObjectPool {
+public:
+    ObjectPool() = default;
+    ~ObjectPool() = default;   // objects still alive are not destroyed
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template<typename... Args>
+    T* Create(Args&&... args) {
+        if (!m_freeList) Grow();
+        Slot* slot = m_freeList;
+        m_freeList = slot->next;
+        ++m_live;
+        ++ThreadAllocationCounters().poolAllocations;
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    void Destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = m_freeList;
+        m_freeList = slot;
+        --m_live;
+    }
+
+    // Pre-allocate room for at least `count` objects.
+    void Reserve(size_t count) {
+        while (Capacity() < count) Grow();
+    }
+
+    size_t LiveCount() const { return m_live; }
+    size_t Capacity() const { return m_blocks.size() * BlockSize; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    void Grow() {
+        auto block = std::make_unique<Slot[]>(BlockSize);
+        // Thread the new slots onto the free list in address order.
+        for (size_t i = BlockSize; i-- > 0;) {
+            block[i].next = m_freeList;
+            m_freeList = &block[i];
+        }
+        m_blocks.push_back(std::move(block));
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> m_blocks;
+    Slot* m_freeList = nullptr;
+    size_t m_live = 0;
+};
+
+} // namespace ednms
@@ -0,0 +1,54 @@
+#include "ProcessMemory.h"
+
+#if defined(__linux__)
+#include <cstdio>
+#include <cstring>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+namespace ednms {
+
+ProcessMemoryInfo QueryProcessMemory() {
+    ProcessMemoryInfo info;
+#if defined(__linux__)
+    // /proc/self/status reports VmRSS and VmHWM in kB.
+    if (FILE* f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), f)) {
+            unsigned long kb = 0;
+            if (std::strncmp(line, "VmRSS:", 6) == 0 && std::sscanf(line + 6, "%lu", &kb) == 1) {
+                info.residentBytes = static_cast<size_t>(kb) * 1024;
+            } else if (std::strncmp(line, "VmHWM:", 6) == 0 && std::sscanf(line + 6, "%lu", &kb) == 1) {
+                info.peakResidentBytes = static_cast<size_t>(kb) * 1024;
+            }
+        }
+        std::fclose(f);
+    }
+#elif defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        info.residentBytes = static_cast<size_t>(pmc.WorkingSetSize);
+        info.peakResidentBytes = static_cast<size_t>(pmc.PeakWorkingSetSize);
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t taskInfo{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&taskInfo), &count) == KERN_SUCCESS) {
+        info.residentBytes = static_cast<size_t>(taskInfo.resident_size);
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        info.peakResidentBytes = static_cast<size_t>(usage.ru_maxrss); // bytes on macOS
+    }
+#endif
+    return info;
+}
+
+} // namespace ednms
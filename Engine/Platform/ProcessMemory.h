@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+
+namespace ednms {
+
+struct ProcessMemoryInfo {
+    size_t residentBytes = 0;   // current resident set size
+    size_t peakResidentBytes = 0;
+};
+
+// Queries the OS for this process' memory usage.
+// Fields are left at 0 on platforms where the value is unavailable.
+ProcessMemoryInfo QueryProcessMemory();
+
+} // namespace ednms
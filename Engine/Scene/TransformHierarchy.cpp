@@ -0,0 +1,223 @@
+#include "TransformHierarchy.h"
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace ednms {
+
+TransformHierarchy::TransformHierarchy(ECSRegistry& registry)
+    : m_registry(registry), m_scratch(16 * 1024) {
+    m_trimTransform = !m_registry.IsChangeTracked<TransformComponent>();
+    m_trimParent = !m_registry.IsChangeTracked<ParentComponent>();
+    m_trimLocalTransform = !m_registry.IsChangeTracked<LocalTransformComponent>();
+    m_registry.EnableChangeTracking<TransformComponent>();
+    m_registry.EnableChangeTracking<ParentComponent>();
+    m_registry.EnableChangeTracking<LocalTransformComponent>();
+}
+
+void TransformHierarchy::Update() {
+    PropagateRoots(0, BeginUpdate());
+    EndUpdate();
+}
+
+void TransformHierarchy::SplitDirtyTrees(size_t parts, std::vector<size_t>& bounds) const {
+    parts = std::max<size_t>(parts, 1);
+    bounds.assign(parts + 1, m_dirtyTrees.size());
+    bounds[0] = 0;
+    const size_t target = (m_stats.nodesUpdated + parts - 1) / parts;
+    size_t part = 1;
+    size_t nodes = 0;
+    for (size_t k = 0; k < m_dirtyTrees.size() && part < parts; ++k) {
+        const Tree& tree = m_trees[m_dirtyTrees[k]];
+        nodes += tree.end - tree.begin - 1;
+        if (nodes >= target) {
+            bounds[part++] = k + 1;
+            nodes = 0;
+        }
+    }
+}
+
+size_t TransformHierarchy::BeginUpdate() {
+    m_dirtyTrees.clear();
+    m_scratch.Reset();
+    if (m_structureDirty || StructureChanged()) {
+        Rebuild();
+    } else {
+        for (EntityID id : m_registry.GetChangedSince<LocalTransformComponent>(m_seenVersion, &m_scratch)) {
+            auto it = m_nodeIndex.find(id);
+            if (it == m_nodeIndex.end() || m_parent[it->second] == NO_PARENT) continue;
+            GatherLocal(it->second);
+            MarkTreeDirty(it->second);
+        }
+        // Attached children's TransformComponent is our own output; only roots drive.
+        for (EntityID id : m_registry.GetChangedSince<TransformComponent>(m_seenVersion, &m_scratch)) {
+            auto it = m_nodeIndex.find(id);
+            if (it != m_nodeIndex.end() && m_parent[it->second] == NO_PARENT) MarkTreeDirty(it->second);
+        }
+    }
+
+    uint32_t nodes = 0;
+    for (uint32_t t = 0; t < m_trees.size(); ++t) {
+        if (!m_treeDirty[t]) continue;
+        GatherRoot(t);
+        m_dirtyTrees.push_back(t);
+        nodes += m_trees[t].end - m_trees[t].begin - 1;
+    }
+    m_stats.dirtyRoots = static_cast<uint32_t>(m_dirtyTrees.size());
+    m_stats.nodesUpdated = nodes;
+    return m_dirtyTrees.size();
+}
+
+void TransformHierarchy::PropagateRoots(size_t firstDirty, size_t lastDirty) {
+    for (size_t k = firstDirty; k < lastDirty; ++k) {
+        const Tree& tree = m_trees[m_dirtyTrees[k]];
+        // Depth-sorted: a node's parent has always been written already.
+        for (uint32_t n = tree.begin + 1; n < tree.end; ++n) {
+            const uint32_t p = m_parent[n];
+            m_worldPosition[n] = m_worldPosition[p] + m_worldRotation[p].Rotate(m_localPosition[n]);
+            m_worldRotation[n] = m_worldRotation[p] * m_localRotation[n];
+        }
+    }
+}
+
+void TransformHierarchy::EndUpdate() {
+    for (uint32_t t : m_dirtyTrees) {
+        const Tree& tree = m_trees[t];
+        for (uint32_t n = tree.begin + 1; n < tree.end; ++n) {
+            if (auto* transform = m_registry.GetComponent<TransformComponent>(m_entity[n])) {
+                transform->position = m_worldPosition[n];
+                transform->rotation = m_worldRotation[n];
+            }
+        }
+        m_treeDirty[t] = 0;
+    }
+    m_seenVersion = m_registry.ObserveChanges();
+    // Everything up to m_seenVersion has been consumed (including our own
+    // writes above), so the logs we own never hold more than one tick.
+    if (m_trimTransform) m_registry.TrimChangeHistory<TransformComponent>(m_seenVersion);
+    if (m_trimParent) m_registry.TrimChangeHistory<ParentComponent>(m_seenVersion);
+    if (m_trimLocalTransform) m_registry.TrimChangeHistory<LocalTransformComponent>(m_seenVersion);
+}
+
+bool TransformHierarchy::StructureChanged() {
+    if (!m_registry.GetChangedSince<ParentComponent>(m_seenVersion, &m_scratch).empty()
+        || !m_registry.GetRemovedSince<ParentComponent>(m_seenVersion, &m_scratch).empty()
+        || !m_registry.GetAddedSince<LocalTransformComponent>(m_seenVersion, &m_scratch).empty()
+        || !m_registry.GetRemovedSince<LocalTransformComponent>(m_seenVersion, &m_scratch).empty()) {
+        return true;
+    }
+    // TransformComponent churns with every spawned ship or projectile; only
+    // entities that are (or would become) part of a tree matter.
+    for (EntityID id : m_registry.GetRemovedSince<TransformComponent>(m_seenVersion, &m_scratch)) {
+        if (m_nodeIndex.find(id) != m_nodeIndex.end()) return true;
+    }
+    for (EntityID id : m_registry.GetAddedSince<TransformComponent>(m_seenVersion, &m_scratch)) {
+        if (m_nodeIndex.find(id) != m_nodeIndex.end()
+            || std::binary_search(m_orphanParents.begin(), m_orphanParents.end(), id)
+            || (m_registry.HasComponent<ParentComponent>(id) && m_registry.HasComponent<LocalTransformComponent>(id))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransformHierarchy::Rebuild() {
+    m_structureDirty = false;
+    ++m_stats.rebuilds;
+
+    // Sorted so the flat layout (and thus write order) is deterministic.
+    EntityList attached = m_registry.GetEntitiesWithMask(
+        ECSRegistry::MaskOf<TransformComponent, ParentComponent, LocalTransformComponent>());
+    std::sort(attached.begin(), attached.end());
+
+    std::unordered_map<EntityID, std::vector<EntityID>> children;
+    std::unordered_set<EntityID> isChild;
+    m_orphanParents.clear();
+    for (EntityID id : attached) {
+        const EntityID parent = std::as_const(m_registry).GetComponent<ParentComponent>(id)->parent;
+        if (parent == id) continue;
+        if (!m_registry.HasEntity(parent) || !m_registry.HasComponent<TransformComponent>(parent)) {
+            // Attaches once the parent gains a TransformComponent.
+            m_orphanParents.push_back(parent);
+            continue;
+        }
+        children[parent].push_back(id);
+        isChild.insert(id);
+    }
+
+    // Roots: parents that are not attached themselves. Cycles have no root
+    // and are skipped.
+    std::vector<EntityID> roots;
+    for (const auto& [parent, list] : children) {
+        if (isChild.find(parent) == isChild.end()) roots.push_back(parent);
+    }
+    std::sort(roots.begin(), roots.end());
+    std::sort(m_orphanParents.begin(), m_orphanParents.end());
+    m_orphanParents.erase(std::unique(m_orphanParents.begin(), m_orphanParents.end()), m_orphanParents.end());
+
+    m_entity.clear();
+    m_parent.clear();
+    m_tree.clear();
+    m_nodeIndex.clear();
+    m_trees.clear();
+    m_stats.maxDepth = 0;
+
+    std::vector<uint32_t> depth;
+    for (EntityID root : roots) {
+        const uint32_t treeIndex = static_cast<uint32_t>(m_trees.size());
+        Tree tree;
+        tree.begin = static_cast<uint32_t>(m_entity.size());
+        m_entity.push_back(root);
+        m_parent.push_back(NO_PARENT);
+        m_tree.push_back(treeIndex);
+        depth.assign(1, 0);
+        // Breadth-first over the flat array itself: appended nodes are the queue.
+        for (uint32_t n = tree.begin; n < m_entity.size(); ++n) {
+            auto it = children.find(m_entity[n]);
+            if (it == children.end()) continue;
+            for (EntityID child : it->second) {
+                m_entity.push_back(child);
+                m_parent.push_back(n);
+                m_tree.push_back(treeIndex);
+                depth.push_back(depth[n - tree.begin] + 1);
+                m_stats.maxDepth = std::max(m_stats.maxDepth, depth.back());
+            }
+        }
+        tree.end = static_cast<uint32_t>(m_entity.size());
+        m_trees.push_back(tree);
+    }
+
+    const size_t count = m_entity.size();
+    m_localPosition.assign(count, Vec3d{});
+    m_localRotation.assign(count, Quatd::Identity());
+    m_worldPosition.assign(count, Vec3d{});
+    m_worldRotation.assign(count, Quatd::Identity());
+    m_nodeIndex.reserve(count);
+    for (uint32_t n = 0; n < count; ++n) {
+        m_nodeIndex.emplace(m_entity[n], n);
+        if (m_parent[n] != NO_PARENT) GatherLocal(n);
+    }
+    m_treeDirty.assign(m_trees.size(), 1);
+
+    m_stats.roots = static_cast<uint32_t>(m_trees.size());
+    m_stats.nodes = static_cast<uint32_t>(count);
+}
+
+void TransformHierarchy::GatherLocal(uint32_t node) {
+    const auto* local = std::as_const(m_registry).GetComponent<LocalTransformComponent>(m_entity[node]);
+    m_localPosition[node] = local->position;
+    m_localRotation[node] = local->rotation;
+}
+
+void TransformHierarchy::GatherRoot(uint32_t tree) {
+    const uint32_t node = m_trees[tree].begin;
+    const auto* world = std::as_const(m_registry).GetComponent<TransformComponent>(m_entity[node]);
+    m_worldPosition[node] = world->position;
+    m_worldRotation[node] = world->rotation;
+}
+
+void TransformHierarchy::MarkTreeDirty(uint32_t node) {
+    m_treeDirty[m_tree[node]] = 1;
+}
+
+} // namespace ednms
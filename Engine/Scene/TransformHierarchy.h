@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Engine/ECS/ecs_registry.h"
+#include "Engine/ECS/components.h"
+#include "Engine/Math/Vec3d.h"
+#include "Engine/Memory/FrameArena.h"
+
+namespace ednms {
+
+// Parent/child transform propagation
+// ----------------------------------
+// Entities with ParentComponent + LocalTransformComponent hang off another
+// entity's frame; their TransformComponent (world space) is derived here.
+// The forest is flattened into one array: each root's subtree is stored
+// contiguously in breadth-first (depth-sorted) order, so every parent sits
+// before its children and propagation is a single linear sweep over SoA
+// arrays instead of a pointer chase per module.
+//
+// Only dirty trees are recomputed: a tree is dirty when its root's
+// TransformComponent or any LocalTransformComponent inside it changed since
+// the last Update(). Reparenting / attach / detach triggers a full rebuild
+// of the flat layout (docking events are rare compared to movement).
+// Entities outside every tree gaining or losing a TransformComponent
+// (spawns, despawns) do not.
+//
+// Run Update() once per tick after the systems that move roots or edit
+// local transforms. Entities whose parent chain does not reach a root
+// (missing parent, cycle) are left untouched.
+//
+// Change history: for each of the three pools whose tracking the hierarchy
+// switched on itself, EndUpdate() trims the log up to what it has consumed,
+// so history stays bounded without any other system's help. Pools that were
+// already tracked belong to whoever enabled them; that owner must not trim
+// past the hierarchy's last EndUpdate() and is responsible for trimming.
+struct HierarchyStats {
+    uint32_t roots = 0;           // trees with at least one attached child
+    uint32_t nodes = 0;           // roots + attached children
+    uint32_t maxDepth = 0;
+    uint32_t dirtyRoots = 0;      // trees recomputed by the last update
+    uint32_t nodesUpdated = 0;    // world transforms written by the last update
+    uint64_t rebuilds = 0;
+};
+
+class TransformHierarchy {
+public:
+    // Enables change tracking on Transform, Parent and LocalTransform pools
+    // (taking ownership of trimming those it enabled).
+    explicit TransformHierarchy(ECSRegistry& registry);
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // BeginUpdate + PropagateRoots over all dirty trees + EndUpdate, on the
+    // calling thread.
+    void Update();
+
+    // Split form for callers that own a job system / worker pool:
+    //   size_t n = hierarchy.BeginUpdate();
+    //   hierarchy.SplitDirtyTrees(workers, bounds);
+    //   for each worker w (in parallel): hierarchy.PropagateRoots(bounds[w], bounds[w + 1]);
+    //   hierarchy.EndUpdate();
+    // PropagateRoots touches only its own trees and never the registry, so
+    // disjoint ranges may run concurrently.
+    size_t BeginUpdate();
+    void PropagateRoots(size_t firstDirty, size_t lastDirty);
+    void EndUpdate();
+
+    // Splits the current dirty trees into `parts` contiguous ranges of
+    // roughly equal node count: bounds[i]..bounds[i + 1] for i < parts.
+    // Call between BeginUpdate() and EndUpdate(); some ranges may be empty.
+    void SplitDirtyTrees(size_t parts, std::vector<size_t>& bounds) const;
+
+    // Force the next update to rebuild and recompute everything.
+    void Invalidate() { m_structureDirty = true; }
+
+    const HierarchyStats& Stats() const { return m_stats; }
+
+private:
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    struct Tree {
+        uint32_t begin = 0;   // first node (the root)
+        uint32_t end = 0;     // one past the last node
+    };
+
+    bool StructureChanged();
+    void Rebuild();
+    void GatherLocal(uint32_t node);
+    void GatherRoot(uint32_t tree);
+    void MarkTreeDirty(uint32_t node);
+
+    ECSRegistry& m_registry;
+    uint64_t m_seenVersion = 0;
+    bool m_structureDirty = true;
+    bool m_trimTransform = false;        // tracking enabled by us, so we trim it
+    bool m_trimParent = false;
+    bool m_trimLocalTransform = false;
+    FrameArena m_scratch;                // change queries; reset every BeginUpdate()
+
+    // Flattened forest (SoA), indexed by node.
+    std::vector<EntityID> m_entity;
+    std::vector<uint32_t> m_parent;    // node index of the parent, NO_PARENT for roots
+    std::vector<uint32_t> m_tree;      // owning tree index
+    std::vector<Vec3d> m_localPosition;
+    std::vector<Quatd> m_localRotation;
+    std::vector<Vec3d> m_worldPosition;
+    std::vector<Quatd> m_worldRotation;
+    std::unordered_map<EntityID, uint32_t> m_nodeIndex;
+    std::vector<EntityID> m_orphanParents;   // sorted; missing parents of attached entities
+
+    std::vector<Tree> m_trees;
+    std::vector<uint8_t> m_treeDirty;
+    std::vector<uint32_t> m_dirtyTrees;   // sorted tree indices for this update
+
+    HierarchyStats m_stats;
+};
+
+} // namespace ednms
@@ -0,0 +1,288 @@
+#include "HeadlessServer.h"
+#include "Engine/Core/Log.h"
+#include "Engine/ECS/components.h"
+#include "Engine/Memory/AllocationCounters.h"
+#include "Engine/Memory/FrameArena.h"
+#include "Engine/Platform/ProcessMemory.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace ednms {
+
+namespace {
+
+bool ParseUInt(const char* text, uint64_t& out) {
+    if (!text || *text == '\0' || *text == '-') return false;
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtoull(text, &end, 10);
+    return end && *end == '\0' && errno != ERANGE;
+}
+
+bool ParseDouble(const char* text, double& out) {
+    if (!text || *text == '\0') return false;
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtod(text, &end);
+    // Rejects "inf"/"nan" and out-of-range literals such as 1e400.
+    return end && *end == '\0' && errno != ERANGE && std::isfinite(out) && out >= 0.0;
+}
+
+LogFixed Ms(double seconds) {
+    return {seconds * 1000.0, 3};
+}
+
+LogFixed MiB(size_t bytes) {
+    return {static_cast<double>(bytes) / (1024.0 * 1024.0), 1};
+}
+
+} // namespace
+
+bool ParseServerArgs(int argc, char** argv, ServerConfig& config, std::string& error) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        uint64_t u = 0;
+        double d = 0.0;
+
+        auto needUInt = [&](uint64_t& dst) {
+            if (!ParseUInt(value, u)) { error = std::string("expected integer after ") + arg; return false; }
+            dst = u; ++i; return true;
+        };
+        auto needUInt32 = [&](uint32_t& dst) {
+            uint64_t tmp = 0;
+            if (!needUInt(tmp)) return false;
+            if (tmp > UINT32_MAX) { error = std::string("value after ") + arg + " exceeds 4294967295"; return false; }
+            dst = static_cast<uint32_t>(tmp);
+            return true;
+        };
+        auto needDouble = [&](double& dst) {
+            if (!ParseDouble(value, d)) { error = std::string("expected finite non-negative number after ") + arg; return false; }
+            dst = d; ++i; return true;
+        };
+
+        if (std::strcmp(arg, "--headless") == 0) {
+            // Mode selector; accepted here so callers can pass argv through unchanged.
+        } else if (std::strcmp(arg, "--ticks") == 0) {
+            if (!needUInt(config.maxTicks)) return false;
+        } else if (std::strcmp(arg, "--tick-rate") == 0) {
+            if (!needDouble(config.timestep.tickRate)) return false;
+            if (config.timestep.tickRate <= 0.0) { error = "--tick-rate must be > 0"; return false; }
+        } else if (std::strcmp(arg, "--max-catch-up") == 0) {
+            if (!needUInt32(config.timestep.maxCatchUpTicks)) return false;
+        } else if (std::strcmp(arg, "--overload") == 0) {
+            if (value && std::strcmp(value, "drop") == 0) {
+                config.timestep.overload = OverloadPolicy::DropTicks;
+            } else if (value && std::strcmp(value, "carry") == 0) {
+                config.timestep.overload = OverloadPolicy::CarryDebt;
+            } else {
+                error = "--overload expects 'drop' or 'carry'";
+                return false;
+            }
+            ++i;
+        } else if (std::strcmp(arg, "--unthrottled") == 0) {
+            config.unthrottled = true;
+        } else if (std::strcmp(arg, "--report-every") == 0) {
+            if (!needUInt(config.reportInterval)) return false;
+        } else if (std::strcmp(arg, "--ships") == 0) {
+            if (!needUInt32(config.ships)) return false;
+        } else if (std::strcmp(arg, "--stations") == 0) {
+            if (!needUInt32(config.stations)) return false;
+        } else if (std::strcmp(arg, "--ship-churn") == 0) {
+            if (!needDouble(config.shipChurn)) return false;
+        } else if (std::strcmp(arg, "--station-churn") == 0) {
+            if (!needDouble(config.stationChurn)) return false;
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            if (!needUInt(config.seed)) return false;
+        } else {
+            error = std::string("unknown option ") + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
+void PrintServerUsage(const char* exe) {
+    std::cout
+        << "Usage: " << exe << " --headless [options]\n"
+        << "  --ticks N            stop after N ticks (0 = run forever, default 600)\n"
+        << "  --tick-rate HZ       simulation ticks per second (default 60)\n"
+        << "  --max-catch-up N     max ticks simulated per frame when behind (default 5)\n"
+        << "  --overload drop|carry  discard or keep time beyond the catch-up budget\n"
+        << "  --unthrottled        run ticks back-to-back without sleeping\n"
+        << "  --report-every N     print stats every N ticks (0 = final only)\n"
+        << "  --ships N            ships in the scenario (default 100)\n"
+        << "  --stations N         stations in the scenario (default 10)\n"
+        << "  --ship-churn R       ships destroyed and respawned per tick\n"
+        << "  --station-churn R    stations destroyed and respawned per tick\n"
+        << "  --seed N             scenario RNG seed (default 1)\n";
+}
+
+HeadlessServer::HeadlessServer(const ServerConfig& config)
+    : m_config(config), m_rng(config.seed) {}
+
+int HeadlessServer::Run() {
+    Log::Info("Headless server: ", m_config.ships, " ships, ", m_config.stations, " stations, ",
+              m_config.timestep.tickRate, " Hz", m_config.unthrottled ? " (unthrottled)" : "");
+
+    SpawnScenario();
+    Report("spawn", m_window);
+
+    using Clock = std::chrono::steady_clock;
+    FixedTimestep timestep(m_config.timestep);
+    const double dt = timestep.TickDuration();
+    const uint64_t limit = m_config.maxTicks;
+
+    FrameArena& arena = ThreadFrameArena();
+    auto runTick = [&]() {
+        ResetThreadAllocationCounters();
+        const auto start = Clock::now();
+        Tick(dt);
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t heapAllocs = ThreadAllocationCounters().heapAllocations;
+        for (FrameStats* stats : {&m_window, &m_total}) {
+            stats->timing.Record(elapsed, dt);
+            stats->heapAllocations += heapAllocs;
+            stats->arenaBytesPeak = std::max<uint64_t>(stats->arenaBytesPeak, arena.BytesUsed());
+        }
+        arena.Reset();
+        ++m_ticksRun;
+        if (m_config.reportInterval > 0 && m_ticksRun % m_config.reportInterval == 0) {
+            Report("tick", m_window);
+            m_window.Reset();
+        }
+    };
+
+    if (m_config.unthrottled) {
+        while (limit == 0 || m_ticksRun < limit) runTick();
+    } else {
+        auto last = Clock::now();
+        while (limit == 0 || m_ticksRun < limit) {
+            const auto now = Clock::now();
+            const double elapsed = std::chrono::duration<double>(now - last).count();
+            last = now;
+
+            uint32_t ticks = timestep.Advance(elapsed);
+            m_droppedTicks = timestep.DroppedTicks();
+            for (uint32_t t = 0; t < ticks && (limit == 0 || m_ticksRun < limit); ++t) {
+                runTick();
+            }
+            if (ticks == 0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(timestep.TimeUntilNextTick()));
+            }
+        }
+    }
+
+    Report("final", m_total);
+    return 0;
+}
+
+void HeadlessServer::SpawnScenario() {
+    m_registry.EnableChangeTracking<PowerComponent>();
+    m_ships.reserve(m_config.ships);
+    m_stations.reserve(m_config.stations);
+    for (uint32_t i = 0; i < m_config.ships; ++i) m_ships.push_back(SpawnShip());
+    for (uint32_t i = 0; i < m_config.stations; ++i) m_stations.push_back(SpawnStation());
+}
+
+EntityID HeadlessServer::SpawnShip() {
+    std::uniform_real_distribution<double> pos(-1.0e6, 1.0e6);
+    std::uniform_real_distribution<double> vel(-300.0, 300.0);
+
+    EntityID ship = m_registry.CreateEntity();
+    m_registry.AddComponent(ship, TransformComponent{
+        Vec3d{pos(m_rng), pos(m_rng), pos(m_rng)}, Quatd::Identity()});
+    m_registry.AddComponent(ship, PhysicsComponent{
+        Vec3d{vel(m_rng), vel(m_rng), vel(m_rng)}, Vec3d{}, 1000.0, false});
+    m_registry.AddComponent(ship, SurvivalComponent{});
+    return ship;
+}
+
+EntityID HeadlessServer::SpawnStation() {
+    std::uniform_real_distribution<double> pos(-1.0e7, 1.0e7);
+    std::uniform_real_distribution<float> power(0.0f, 2.0e6f);
+
+    EntityID station = m_registry.CreateEntity();
+    m_registry.AddComponent(station, TransformComponent{
+        Vec3d{pos(m_rng), pos(m_rng), pos(m_rng)}, Quatd::Identity()});
+    m_registry.AddComponent(station, PowerComponent{power(m_rng), power(m_rng), false});
+    m_registry.AddComponent(station, OwnershipComponent{1, 0xFF});
+    m_registry.AddComponent(station, InventoryComponent{{{1, 1000}, {2, 500}}});
+    return station;
+}
+
+void HeadlessServer::Tick(double dt) {
+    m_registry.AdvanceTick();
+
+    // Arrivals/departures happen first so this tick's systems see them.
+    ApplyChurn(m_ships, m_config.shipChurn, m_shipChurnCarry, &HeadlessServer::SpawnShip);
+    ApplyChurn(m_stations, m_config.stationChurn, m_stationChurnCarry, &HeadlessServer::SpawnStation);
+
+    // Physics: integrate ship positions.
+    for (EntityID id : m_ships) {
+        auto* transform = m_registry.GetComponent<TransformComponent>(id);
+        const auto* physics = std::as_const(m_registry).GetComponent<PhysicsComponent>(id);
+        if (transform && physics && !physics->isStatic) {
+            transform->position += physics->velocity * dt;
+        }
+    }
+
+    // Power: stations are powered while generation covers consumption.
+    // Only re-evaluated for stations whose PowerComponent changed since last run.
+    for (EntityID id : m_registry.GetChangedSince<PowerComponent>(m_powerSeenVersion, &ThreadFrameArena())) {
+        const auto* power = std::as_const(m_registry).GetComponent<PowerComponent>(id);
+        const bool powered = power->generated >= power->consumed;
+        if (power->powered != powered) {
+            m_registry.GetComponent<PowerComponent>(id)->powered = powered;
+        }
+    }
+    m_powerSeenVersion = m_registry.ObserveChanges();
+
+    // The power pass is the only consumer of PowerComponent events.
+    m_registry.TrimChangeHistory<PowerComponent>(m_powerSeenVersion);
+}
+
+void HeadlessServer::ApplyChurn(std::vector<EntityID>& entities, double rate, double& carry,
+                                EntityID (HeadlessServer::*spawn)()) {
+    // Fractional rates accumulate so e.g. 0.25 churns one entity every 4 ticks.
+    carry += rate;
+    while (carry >= 1.0 && !entities.empty()) {
+        carry -= 1.0;
+        std::uniform_int_distribution<size_t> pick(0, entities.size() - 1);
+        const size_t index = pick(m_rng);
+        m_registry.DestroyEntity(entities[index]);
+        ++m_destroyed;
+        entities[index] = (this->*spawn)();
+    }
+}
+
+void HeadlessServer::Report(const char* label, const FrameStats& stats) const {
+    const ProcessMemoryInfo mem = QueryProcessMemory();
+    LogLine line;
+    line.AppendAll("[", label, "] tick ", m_ticksRun, " | entities ", m_registry.EntityCount(),
+                   " | churned ", m_destroyed);
+    const TickTimingStats& timing = stats.timing;
+    if (timing.samples > 0) {
+        line.AppendAll(" | tick ms min/avg/max ", Ms(timing.min), "/", Ms(timing.Mean()), "/",
+                       Ms(timing.max), " | over budget ", timing.overBudget);
+        if (HeapAllocationCountingEnabled()) {
+            line.AppendAll(" | heap allocs/tick ", stats.heapAllocations / timing.samples);
+        }
+        line.AppendAll(" | arena peak ", stats.arenaBytesPeak, " B");
+    }
+    if (!m_config.unthrottled) {
+        line.AppendAll(" | dropped ", m_droppedTicks);
+    }
+    line.AppendAll(" | rss ", MiB(mem.residentBytes), " MiB (peak ", MiB(mem.peakResidentBytes), " MiB)");
+    Log::Write(LogLevel::Info, line.View());
+}
+
+} // namespace ednms
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "Engine/Core/FixedTimestep.h"
+#include "Engine/ECS/ecs_registry.h"
+
+namespace ednms {
+
+// Scenario and loop settings for the headless server / soak-test harness.
+struct ServerConfig {
+    FixedTimestepConfig timestep;
+    bool unthrottled = false;       // run ticks back-to-back, ignoring wall-clock
+    uint64_t maxTicks = 600;        // 0 = run until killed
+    uint64_t reportInterval = 60;   // ticks between stat reports, 0 = final only
+
+    uint32_t ships = 100;
+    uint32_t stations = 10;
+    double shipChurn = 0.0;         // ships destroyed + respawned per tick
+    double stationChurn = 0.0;      // stations destroyed + respawned per tick
+    uint64_t seed = 1;
+};
+
+// Parses `--headless` style command-line options into `config`.
+// Returns false and fills `error` on unknown options or malformed values.
+bool ParseServerArgs(int argc, char** argv, ServerConfig& config, std::string& error);
+
+void PrintServerUsage(const char* exe);
+
+class HeadlessServer {
+public:
+    explicit HeadlessServer(const ServerConfig& config);
+
+    // Runs the fixed-timestep loop until maxTicks is reached. Returns an exit code.
+    int Run();
+
+    const ECSRegistry& Registry() const { return m_registry; }
+    uint64_t TicksRun() const { return m_ticksRun; }
+
+private:
+    void SpawnScenario();
+    EntityID SpawnShip();
+    EntityID SpawnStation();
+    void Tick(double dt);
+    void ApplyChurn(std::vector<EntityID>& entities, double rate, double& carry,
+                    EntityID (HeadlessServer::*spawn)());
+    struct FrameStats {
+        TickTimingStats timing;
+        uint64_t heapAllocations = 0;
+        uint64_t arenaBytesPeak = 0;
+
+        void Reset() { *this = FrameStats{}; }
+    };
+
+    void Report(const char* label, const FrameStats& stats) const;
+
+    ServerConfig m_config;
+    ECSRegistry m_registry;
+    std::mt19937_64 m_rng;
+    std::vector<EntityID> m_ships;
+    std::vector<EntityID> m_stations;
+    double m_shipChurnCarry = 0.0;
+    double m_stationChurnCarry = 0.0;
+    uint64_t m_powerSeenVersion = 0;
+    uint64_t m_ticksRun = 0;
+    uint64_t m_destroyed = 0;
+    uint64_t m_droppedTicks = 0;
+    FrameStats m_window;
+    FrameStats m_total;
+};
+
+} // namespace ednms
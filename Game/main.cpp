@@ -2,8 +2,36 @@
 #include "Engine/ECS/ecs_registry.h"
 #include "Engine/ECS/components.h"
 #include "Engine/Math/Vec3d.h"
+#include "Game/Server/HeadlessServer.h"
+#include <cstring>
+
+namespace {
+
+int RunHeadless(int argc, char** argv) {
+    ednms::ServerConfig config;
+    std::string error;
+    if (!ednms::ParseServerArgs(argc, argv, config, error)) {
+        ednms::Log::Error(error);
+        ednms::PrintServerUsage(argv[0]);
+        return 2;
+    }
+    ednms::HeadlessServer server(config);
+    return server.Run();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            ednms::PrintServerUsage(argv[0]);
+            return 0;
+        }
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return RunHeadless(argc, argv);
+        }
+    }
 
-int main() {
     ednms::Log::Info("EDNMS Engine starting...");
 
     // Create the ECS registry
@@ -22,21 +50,18 @@ int main() {
         false                           // not static
     });
 
-    ednms::Log::Info("Ship entity created (ID: " + std::to_string(ship) + ")");
+    ednms::Log::Info("Ship entity created (ID: ", ship, ")");
 
     auto* transform = registry.GetComponent<ednms::TransformComponent>(ship);
     auto* physics = registry.GetComponent<ednms::PhysicsComponent>(ship);
 
     if (transform && physics) {
-        ednms::Log::Info("Ship position: ("
-            + std::to_string(transform->position.x) + ", "
-            + std::to_string(transform->position.y) + ", "
-            + std::to_string(transform->position.z) + ")");
-        ednms::Log::Info("Ship mass: " + std::to_string(physics->mass) + " kg");
+        ednms::Log::Info("Ship position: (", transform->position.x, ", ",
+                         transform->position.y, ", ", transform->position.z, ")");
+        ednms::Log::Info("Ship mass: ", physics->mass, " kg");
     }
 
-    ednms::Log::Info("EDNMS Engine initialized. Entities: "
-        + std::to_string(registry.EntityCount()));
+    ednms::Log::Info("EDNMS Engine initialized. Entities: ", registry.EntityCount());
     ednms::Log::Info("Ready for development. See QUICKSTART.md for next steps.");
 
     return 0;
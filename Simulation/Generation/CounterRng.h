@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+
+namespace ednms {
+
+// Counter-based random numbers: the value for (key, counter) is a pure hash,
+// so any sector/system/planet can be generated in any order, on any thread,
+// and always produce the same result. Integer-only mixing keeps output
+// identical across compilers and platforms.
+
+// SplitMix64 finaliser.
+inline uint64_t Mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+inline uint64_t HashCombine(uint64_t seed, uint64_t value) {
+    return Mix64(seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2)));
+}
+
+inline uint64_t CounterHash(uint64_t key, uint64_t counter) {
+    return Mix64(key ^ Mix64(counter + 0x9E3779B97F4A7C15ull));
+}
+
+// Sequential stream over CounterHash(key, 0), (key, 1), ...
+class CounterRng {
+public:
+    explicit CounterRng(uint64_t key, uint64_t counter = 0) : m_key(key), m_counter(counter) {}
+
+    uint64_t NextU64() { return CounterHash(m_key, m_counter++); }
+
+    // Uniform in [0, 1) with 53 bits of precision.
+    double NextDouble() { return static_cast<double>(NextU64() >> 11) * (1.0 / 9007199254740992.0); }
+
+    double NextRange(double lo, double hi) { return lo + (hi - lo) * NextDouble(); }
+
+    // Uniform in [0, bound) (bound > 0), using Lemire's multiply-shift.
+    uint32_t NextBelow(uint32_t bound) {
+        return static_cast<uint32_t>(((NextU64() >> 32) * uint64_t{bound}) >> 32);
+    }
+
+    uint64_t Key() const { return m_key; }
+    uint64_t Counter() const { return m_counter; }
+
+private:
+    uint64_t m_key;
+    uint64_t m_counter;
+};
+
+} // namespace ednms
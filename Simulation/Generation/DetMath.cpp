@@ -0,0 +1,40 @@
+#include "DetMath.h"
+#include <cfloat>
+#include <cmath>
+
+// Extended-precision intermediates (x87) would change results per compiler.
+static_assert(FLT_EVAL_METHOD == 0, "deterministic math needs double evaluation (e.g. SSE2)");
+
+namespace ednms {
+
+double DetExp(double x) {
+    if (!(x > -745.2)) return x != x ? x : 0.0;
+    if (x > 709.78) return HUGE_VAL;
+
+    // Cody-Waite reduction x = k*ln2 + r, |r| <= ln2/2. LN2_HI has its low
+    // bits clear so k * LN2_HI is exact.
+    constexpr double LOG2E = 1.44269504088896338700e+00;
+    constexpr double LN2_HI = 6.93147180369123816490e-01;
+    constexpr double LN2_LO = 1.90821492927058770002e-10;
+    const double k = std::floor(x * LOG2E + 0.5);
+    const double r = (x - k * LN2_HI) - k * LN2_LO;
+
+    // Taylor series to r^13; the truncation error is below 2^-53 for |r| <= ln2/2.
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+    return std::ldexp(p, static_cast<int>(k));
+}
+
+} // namespace ednms
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace ednms {
+
+// Reproducible transcendental math for generation code.
+//
+// std::exp/log/pow/cos are only required to be "close" and differ between
+// libm implementations, so anything that must regenerate bit-identically on
+// every platform uses these instead. They are built from IEEE basic
+// operations (+ - * /), floor and ldexp, which are exact or correctly
+// rounded everywhere; DetMath.cpp is compiled with FMA contraction off so
+// the operation sequence is the one written.
+
+// e^x, accurate to ~1 ulp. Returns 0 below -745 and +inf above 709.78.
+double DetExp(double x);
+
+} // namespace ednms
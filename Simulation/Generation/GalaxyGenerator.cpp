@@ -0,0 +1,254 @@
+#include "GalaxyGenerator.h"
+#include "CounterRng.h"
+#include "DetMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ednms {
+
+namespace {
+
+// Main-sequence class distribution (cumulative), O rarest, M most common.
+struct ClassInfo {
+    StarClass starClass;
+    double cumulative;
+    double minMass, maxMass;   // solar masses
+    uint32_t maxPlanets;
+};
+
+constexpr ClassInfo CLASS_TABLE[] = {
+    {StarClass::O, 0.0000003, 16.0, 60.0,  2},
+    {StarClass::B, 0.0013,    2.1,  16.0,  4},
+    {StarClass::A, 0.0073,    1.4,  2.1,   6},
+    {StarClass::F, 0.0373,    1.04, 1.4,   9},
+    {StarClass::G, 0.1133,    0.8,  1.04,  10},
+    {StarClass::K, 0.2343,    0.45, 0.8,   8},
+    {StarClass::M, 1.0,       0.08, 0.45,  6},
+};
+
+const ClassInfo& InfoFor(StarClass starClass) {
+    return CLASS_TABLE[static_cast<size_t>(starClass)];
+}
+
+// Stream salts so sector, system and planet draws never share counters.
+constexpr uint64_t SALT_COUNT = 0x436F756E74ull;    // "Count"
+constexpr uint64_t SALT_SYSTEM = 0x53797374656Dull; // "System"
+constexpr uint64_t SALT_PLANET = 0x506C616E6574ull; // "Planet"
+
+int32_t SignExtend(uint64_t value, unsigned bits) {
+    const uint64_t sign = uint64_t{1} << (bits - 1);
+    return static_cast<int32_t>(static_cast<int64_t>((value ^ sign) - sign));
+}
+
+// Poisson(lambda) by inverting the CDF with one uniform per draw. Only basic
+// IEEE operations and DetExp are involved, so the count is bit-identical on
+// every platform. Means above POISSON_PIECE are split into equal parts
+// (a sum of Poissons is Poisson) so e^-lambda never underflows. Stops at
+// limit, since callers clamp to it anyway.
+constexpr double POISSON_PIECE = 256.0;
+
+uint32_t SamplePoissonPiece(CounterRng& rng, double lambda, uint32_t limit) {
+    const double u = rng.NextDouble();
+    double p = DetExp(-lambda);
+    double cdf = p;
+    uint32_t k = 0;
+    while (u > cdf && k < limit) {
+        ++k;
+        p *= lambda / k;
+        const double next = cdf + p;
+        if (next == cdf) break;   // tail exhausted in double precision
+        cdf = next;
+    }
+    return k;
+}
+
+uint32_t SamplePoisson(CounterRng& rng, double lambda, uint32_t limit) {
+    if (!(lambda > 0.0)) return 0;
+    const double pieces = std::ceil(lambda / POISSON_PIECE);
+    const double piece = lambda / pieces;
+    uint32_t total = 0;
+    for (double i = 0.0; i < pieces && total < limit; i += 1.0) {
+        total += SamplePoissonPiece(rng, piece, limit - total);
+    }
+    return total;
+}
+
+} // namespace
+
+uint64_t MakeSystemId(const ChunkCoord& sector, uint32_t index) {
+    return (uint64_t{static_cast<uint32_t>(sector.x) & 0xFFFFFu} << 44)
+         | (uint64_t{static_cast<uint32_t>(sector.z) & 0xFFFFFu} << 24)
+         | (uint64_t{static_cast<uint32_t>(sector.y) & 0xFFFu} << 12)
+         | (uint64_t{index} & 0xFFFu);
+}
+
+ChunkCoord SystemSector(uint64_t systemId) {
+    ChunkCoord c;
+    c.x = SignExtend((systemId >> 44) & 0xFFFFFu, 20);
+    c.z = SignExtend((systemId >> 24) & 0xFFFFFu, 20);
+    c.y = SignExtend((systemId >> 12) & 0xFFFu, 12);
+    return c;
+}
+
+uint32_t SystemIndex(uint64_t systemId) {
+    return static_cast<uint32_t>(systemId & 0xFFFu);
+}
+
+// --- GalaxyGenerator ---
+
+uint64_t GalaxyGenerator::SectorKey(const ChunkCoord& sector) const {
+    uint64_t key = HashCombine(m_config.galaxySeed, static_cast<uint32_t>(sector.x));
+    key = HashCombine(key, static_cast<uint32_t>(sector.y));
+    return HashCombine(key, static_cast<uint32_t>(sector.z));
+}
+
+double GalaxyGenerator::ExpectedStarCount(const ChunkCoord& sector) const {
+    const double s = m_config.sectorSize;
+    const double cx = (sector.x + 0.5) * s;
+    const double cy = (sector.y + 0.5) * s;
+    const double cz = (sector.z + 0.5) * s;
+    const double r = std::sqrt(cx * cx + cz * cz);
+    if (r > m_config.discRadius) return 0.0;
+
+    // Exponential disc plus a Gaussian central bulge.
+    const double disc = DetExp(-r / m_config.discScaleLength - std::abs(cy) / m_config.discScaleHeight);
+    const double bulgeRadius = 0.1 * m_config.discRadius;
+    const double bulge = 2.0 * DetExp(-(r * r + cy * cy) / (2.0 * bulgeRadius * bulgeRadius));
+    return m_config.localDensity * (disc + bulge) * s * s * s;
+}
+
+SectorContent GalaxyGenerator::GenerateSector(const ChunkCoord& sector) const {
+    SectorContent content;
+    content.coord = sector;
+
+    CounterRng countRng(HashCombine(SectorKey(sector), SALT_COUNT));
+    const uint32_t count = SamplePoisson(countRng, ExpectedStarCount(sector), MAX_SYSTEMS_PER_SECTOR);
+    content.systems.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        content.systems.push_back(GenerateSummary(sector, i));
+    }
+    return content;
+}
+
+StarSystemSummary GalaxyGenerator::GenerateSummary(const ChunkCoord& sector, uint32_t index) const {
+    const uint64_t systemId = MakeSystemId(sector, index);
+    CounterRng rng(HashCombine(SectorKey(sector), HashCombine(SALT_SYSTEM, index)));
+
+    StarSystemSummary summary;
+    summary.systemId = systemId;
+    const double s = m_config.sectorSize;
+    summary.x = (sector.x + rng.NextDouble()) * s;
+    summary.y = (sector.y + rng.NextDouble()) * s;
+    summary.z = (sector.z + rng.NextDouble()) * s;
+
+    const double roll = rng.NextDouble();
+    for (const ClassInfo& info : CLASS_TABLE) {
+        if (roll < info.cumulative) {
+            summary.starClass = info.starClass;
+            break;
+        }
+    }
+    summary.planetCount = static_cast<uint8_t>(rng.NextBelow(InfoFor(summary.starClass).maxPlanets + 1));
+    return summary;
+}
+
+StarSystem GalaxyGenerator::GenerateSystem(uint64_t systemId) const {
+    const ChunkCoord sector = SystemSector(systemId);
+    const uint32_t index = SystemIndex(systemId);
+
+    StarSystem system;
+    system.summary = GenerateSummary(sector, index);
+
+    const ClassInfo& info = InfoFor(system.summary.starClass);
+    const uint64_t systemKey = HashCombine(SectorKey(sector), HashCombine(SALT_SYSTEM, index));
+    CounterRng rng(HashCombine(systemKey, SALT_PLANET));
+    system.starMass = rng.NextRange(info.minMass, info.maxMass);
+
+    // Habitable band and frost line scale with luminosity (~ mass^3.5),
+    // spelled out with sqrt because std::pow is not reproducible across libms.
+    const double luminosity = system.starMass * system.starMass * system.starMass * std::sqrt(system.starMass);
+    const double habitableInner = 0.95 * std::sqrt(luminosity);
+    const double habitableOuter = 1.37 * std::sqrt(luminosity);
+    const double frostLine = 2.7 * std::sqrt(luminosity);
+
+    system.planets.reserve(system.summary.planetCount);
+    double orbit = 0.2 * std::sqrt(system.starMass) * rng.NextRange(0.7, 1.3);
+    for (uint32_t p = 0; p < system.summary.planetCount; ++p) {
+        PlanetInfo planet;
+        planet.planetId = HashCombine(systemId, p);
+        planet.orbitRadiusAU = orbit;
+
+        const bool giant = orbit > frostLine && rng.NextDouble() < 0.6;
+        planet.radiusKm = static_cast<float>(giant ? rng.NextRange(20000.0, 75000.0)
+                                                   : rng.NextRange(1500.0, 12000.0));
+        const double density = giant ? rng.NextRange(0.6, 1.7) : rng.NextRange(3.0, 6.0);   // g/cm^3
+        // Surface gravity relative to Earth: (density / 5.51) * (radius / 6371).
+        planet.gravity = static_cast<float>((density / 5.51) * (planet.radiusKm / 6371.0));
+        planet.hasAtmosphere = giant || rng.NextDouble() < std::min(1.0, planet.radiusKm / 8000.0);
+        planet.hasWater = !giant && planet.hasAtmosphere
+            && orbit >= habitableInner && orbit <= habitableOuter && rng.NextDouble() < 0.5;
+
+        system.planets.push_back(planet);
+        orbit *= rng.NextRange(1.4, 2.0);   // Titius-Bode-like spacing
+    }
+    return system;
+}
+
+// --- GalaxyCache ---
+
+size_t GalaxyCache::ChunkCoordHash::operator()(const ChunkCoord& c) const {
+    uint64_t h = HashCombine(static_cast<uint32_t>(c.x), static_cast<uint32_t>(c.y));
+    return static_cast<size_t>(HashCombine(h, static_cast<uint32_t>(c.z)));
+}
+
+std::shared_ptr<const SectorContent> GalaxyCache::GetSector(const ChunkCoord& sector) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(sector);
+        if (it != m_entries.end()) {
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+            ++m_stats.hits;
+            return it->second.content;
+        }
+        ++m_stats.misses;
+    }
+
+    auto content = std::make_shared<const SectorContent>(m_generator.GenerateSector(sector));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(sector);
+    if (it != m_entries.end()) {
+        // Another thread generated it meanwhile; results are identical.
+        return it->second.content;
+    }
+    m_lru.push_front(sector);
+    m_entries.emplace(sector, Entry{content, m_lru.begin()});
+    while (m_entries.size() > m_capacity) {
+        m_entries.erase(m_lru.back());
+        m_lru.pop_back();
+        ++m_stats.evictions;
+    }
+    return content;
+}
+
+void GalaxyCache::Prefetch(const std::vector<ChunkCoord>& sectors) {
+    for (const ChunkCoord& sector : sectors) GetSector(sector);
+}
+
+size_t GalaxyCache::Size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+GalaxyCacheStats GalaxyCache::Stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void GalaxyCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+}
+
+} // namespace ednms
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "Simulation/World/Chunk.h"
+
+namespace ednms {
+
+// Procedural galaxy generation as described in TECHNICAL_SPECS.md.
+//
+// The galaxy is split into cubic sectors addressed by ChunkCoord. Everything
+// is derived from (galaxySeed, coordinates) through CounterRng, so a sector
+// or system can be generated on demand, independently and in parallel, and
+// regenerates bit-identically. Saves only need player-made deltas on top.
+//
+// Bit-identical across platforms, not just runs: generation uses only IEEE
+// basic operations, sqrt and DetExp (no std::exp/log/pow/cos), and the
+// library is built with FMA contraction off.
+
+enum class StarClass : uint8_t { O, B, A, F, G, K, M };
+
+struct GalaxyConfig {
+    uint64_t galaxySeed = 0x45444E4D53ull;   // "EDNMS"
+    double sectorSize = 10.0;                // light years per sector edge
+    double discRadius = 50000.0;             // light years
+    double discScaleLength = 12000.0;        // radial density falloff
+    double discScaleHeight = 1000.0;         // vertical density falloff
+    double localDensity = 0.035;             // stars / ly^3 in the plane at the centre
+                                             // (~0.004 at the Sun's radius)
+};
+
+struct PlanetInfo {
+    uint64_t planetId = 0;
+    double orbitRadiusAU = 0.0;
+    float radiusKm = 0.0f;
+    float gravity = 0.0f;        // in g
+    bool hasAtmosphere = false;
+    bool hasWater = false;
+};
+
+// Cheap per-system summary produced when a sector is streamed in.
+struct StarSystemSummary {
+    uint64_t systemId = 0;
+    double x = 0.0, y = 0.0, z = 0.0;   // light years, galactic frame
+    StarClass starClass = StarClass::M;
+    uint8_t planetCount = 0;
+};
+
+// Full system detail, generated only when a system is visited.
+struct StarSystem {
+    StarSystemSummary summary;
+    double starMass = 0.0;        // solar masses
+    std::vector<PlanetInfo> planets;
+};
+
+struct SectorContent {
+    ChunkCoord coord;
+    std::vector<StarSystemSummary> systems;
+};
+
+// System IDs pack the owning sector and the index inside it:
+//   [x:20][z:20][y:12][index:12]   (coordinates are two's-complement truncated)
+static constexpr uint32_t MAX_SYSTEMS_PER_SECTOR = 4096;
+
+uint64_t MakeSystemId(const ChunkCoord& sector, uint32_t index);
+ChunkCoord SystemSector(uint64_t systemId);
+uint32_t SystemIndex(uint64_t systemId);
+
+class GalaxyGenerator {
+public:
+    explicit GalaxyGenerator(const GalaxyConfig& config = {}) : m_config(config) {}
+
+    // Pure functions of the config and arguments; safe to call concurrently.
+    SectorContent GenerateSector(const ChunkCoord& sector) const;
+    StarSystem GenerateSystem(uint64_t systemId) const;
+
+    // Expected star count for a sector (galactic density model).
+    double ExpectedStarCount(const ChunkCoord& sector) const;
+
+    const GalaxyConfig& Config() const { return m_config; }
+
+private:
+    StarSystemSummary GenerateSummary(const ChunkCoord& sector, uint32_t index) const;
+    uint64_t SectorKey(const ChunkCoord& sector) const;
+
+    GalaxyConfig m_config;
+};
+
+struct GalaxyCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+// LRU cache of generated sectors in front of a GalaxyGenerator.
+// GetSector() is what the chunk scheduler calls when a region streams in;
+// generation runs outside the lock so concurrent misses do not serialise.
+class GalaxyCache {
+public:
+    GalaxyCache(const GalaxyGenerator& generator, size_t capacity)
+        : m_generator(generator), m_capacity(capacity > 0 ? capacity : 1) {}
+
+    std::shared_ptr<const SectorContent> GetSector(const ChunkCoord& sector);
+
+    // Generate (if needed) a batch of sectors ahead of the player.
+    void Prefetch(const std::vector<ChunkCoord>& sectors);
+
+    size_t Size() const;
+    size_t Capacity() const { return m_capacity; }
+    GalaxyCacheStats Stats() const;
+    void Clear();
+
+private:
+    struct Entry {
+        std::shared_ptr<const SectorContent> content;
+        std::list<ChunkCoord>::iterator lruPos;
+    };
+
+    // Keyed on the full coordinate: distinct sectors never share an entry.
+    struct ChunkCoordHash {
+        size_t operator()(const ChunkCoord& c) const;
+    };
+
+    const GalaxyGenerator& m_generator;
+    size_t m_capacity;
+    mutable std::mutex m_mutex;
+    std::list<ChunkCoord> m_lru;   // front = most recently used
+    std::unordered_map<ChunkCoord, Entry, ChunkCoordHash> m_entries;
+    GalaxyCacheStats m_stats;
+};
+
+} // namespace ednms
@@ -7,6 +7,10 @@ struct ChunkCoord {
     int32_t x = 0;
     int32_t y = 0;
     int32_t z = 0;
+
+    bool operator==(const ChunkCoord& other) const {
+        return x == other.x && y == other.y && z == other.z;
+    }
 };
 
 enum class ChunkSimState {
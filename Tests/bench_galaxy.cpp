@@ -0,0 +1,113 @@
+// Galaxy generation throughput benchmark.
+// Not run by ctest; build EDNMSBench and run it directly:
+//   ./EDNMSBench [sectors-per-axis] [threads]
+#include "Simulation/Generation/GalaxyGenerator.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void PrintRate(const char* label, uint64_t count, const char* unit, double seconds) {
+    std::cout << std::left << std::setw(34) << label << std::right << std::setw(12) << count << " "
+              << unit << " in " << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms  ("
+              << std::setprecision(0) << count / seconds << " " << unit << "/s)" << std::endl;
+}
+
+// Cube of sectors centred on the Sun's galactic radius.
+std::vector<ednms::ChunkCoord> SectorBlock(int32_t n) {
+    std::vector<ednms::ChunkCoord> coords;
+    coords.reserve(static_cast<size_t>(n) * n * n);
+    for (int32_t x = 0; x < n; ++x)
+        for (int32_t y = -n / 2; y < n - n / 2; ++y)
+            for (int32_t z = 0; z < n; ++z)
+                coords.push_back({2600 + x, y, z});
+    return coords;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int32_t n = argc > 1 ? std::atoi(argv[1]) : 32;
+    const unsigned hw = std::thread::hardware_concurrency();
+    const unsigned threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : (hw > 0 ? hw : 4);
+
+    ednms::GalaxyGenerator gen;
+    const std::vector<ednms::ChunkCoord> coords = SectorBlock(n);
+    std::cout << "EDNMS galaxy generation benchmark (" << coords.size() << " sectors of "
+              << gen.Config().sectorSize << " ly)" << std::endl;
+
+    // 1. Single-threaded sector summaries.
+    uint64_t systems = 0;
+    std::vector<uint64_t> systemIds;
+    auto start = Clock::now();
+    for (const ednms::ChunkCoord& c : coords) {
+        const ednms::SectorContent content = gen.GenerateSector(c);
+        systems += content.systems.size();
+        for (const auto& s : content.systems) systemIds.push_back(s.systemId);
+    }
+    double t = Seconds(start);
+    PrintRate("sectors (1 thread)", coords.size(), "sectors", t);
+    PrintRate("system summaries (1 thread)", systems, "systems", t);
+
+    // 2. Full system detail (planets) for every system found.
+    uint64_t planets = 0;
+    start = Clock::now();
+    for (uint64_t id : systemIds) planets += gen.GenerateSystem(id).planets.size();
+    t = Seconds(start);
+    PrintRate("full systems (1 thread)", systemIds.size(), "systems", t);
+    PrintRate("planets (1 thread)", planets, "planets", t);
+
+    // 3. Parallel sector generation: no shared state, so it should scale.
+    std::atomic<size_t> next{0};
+    std::atomic<uint64_t> parallelSystems{0};
+    start = Clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < threads; ++w) {
+        workers.emplace_back([&]() {
+            uint64_t local = 0;
+            for (size_t i = next++; i < coords.size(); i = next++) {
+                local += gen.GenerateSector(coords[i]).systems.size();
+            }
+            parallelSystems += local;
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    t = Seconds(start);
+    const std::string label = "sectors (" + std::to_string(threads) + " threads)";
+    PrintRate(label.c_str(), coords.size(), "sectors", t);
+    if (parallelSystems != systems) {
+        std::cerr << "Parallel generation diverged from serial run!" << std::endl;
+        return 1;
+    }
+
+    // 4. Streaming through a cache: a straight flight along +x revisiting
+    //    a 5x5x5 neighbourhood each step, as the chunk scheduler would.
+    ednms::GalaxyCache cache(gen, 4096);
+    uint64_t lookups = 0;
+    start = Clock::now();
+    for (int32_t step = 0; step < 1000; ++step) {
+        for (int32_t dx = -2; dx <= 2; ++dx)
+            for (int32_t dy = -2; dy <= 2; ++dy)
+                for (int32_t dz = -2; dz <= 2; ++dz, ++lookups)
+                    cache.GetSector({2600 + step + dx, dy, dz});
+    }
+    t = Seconds(start);
+    const ednms::GalaxyCacheStats stats = cache.Stats();
+    PrintRate("cached streaming lookups", lookups, "lookups", t);
+    std::cout << "  hit rate " << std::setprecision(1)
+              << 100.0 * static_cast<double>(stats.hits) / static_cast<double>(lookups) << "%, "
+              << stats.evictions << " evictions" << std::endl;
+    return 0;
+}
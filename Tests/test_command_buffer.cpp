@@ -0,0 +1,193 @@
+#include "test_framework.h"
+#include "Engine/ECS/ecs_command_buffer.h"
+#include "Engine/ECS/components.h"
+#include "Engine/Memory/FrameArena.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(CommandBuffer, DeferredUntilPlayback) {
+    ednms::ECSRegistry registry;
+    ednms::CommandBufferSet commands(1);
+    ednms::CommandBuffer& cb = commands.ForWorker(0);
+
+    ednms::EntityID shot = cb.CreateEntity();
+    cb.AddComponent(shot, ednms::TransformComponent{{5.0, 0.0, 0.0}, {}});
+    EXPECT_TRUE(ednms::IsProvisional(shot));
+    EXPECT_EQ(registry.EntityCount(), 0u);
+    EXPECT_EQ(commands.PendingCommands(), 2u);
+
+    EXPECT_EQ(commands.Playback(registry), 2u);
+    EXPECT_EQ(registry.EntityCount(), 1u);
+    EXPECT_EQ(commands.PendingCommands(), 0u);
+
+    const ednms::EntityID real = commands.Resolve(shot);
+    EXPECT_FALSE(ednms::IsProvisional(real));
+    auto* t = registry.GetComponent<ednms::TransformComponent>(real);
+    EXPECT_TRUE(t != nullptr);
+    EXPECT_NEAR(t->position.x, 5.0, 1e-12);
+    return true;
+}
+
+TEST(CommandBuffer, DestroyAndRemove) {
+    ednms::ECSRegistry registry;
+    ednms::EntityID debris = registry.CreateEntity();
+    ednms::EntityID ship = registry.CreateEntity();
+    registry.AddComponent(ship, ednms::DockingComponent{});
+
+    ednms::CommandBufferSet commands(1);
+    ednms::CommandBuffer& cb = commands.ForWorker(0);
+    cb.DestroyEntity(debris);
+    cb.AddComponent(debris, ednms::PowerComponent{});   // target already gone: skipped
+    cb.RemoveComponent<ednms::DockingComponent>(ship);
+
+    EXPECT_EQ(commands.Playback(registry), 2u);
+    EXPECT_FALSE(registry.HasEntity(debris));
+    EXPECT_FALSE(registry.HasComponent<ednms::DockingComponent>(ship));
+    return true;
+}
+
+TEST(CommandBuffer, PlaybackOrderIsDeterministic) {
+    // Same logical work split across workers in different ways must give
+    // identical entity IDs and component values.
+    auto run = [](bool reversed) {
+        ednms::ECSRegistry registry;
+        ednms::CommandBufferSet commands(2);
+        for (uint64_t src = 1; src <= 6; ++src) {
+            const size_t worker = reversed ? (src % 2) : ((src + 1) % 2);
+            ednms::CommandBuffer& cb = commands.ForWorker(worker);
+            cb.SetSortKey(src);
+            ednms::EntityID e = cb.CreateEntity();
+            cb.AddComponent(e, ednms::PhysicsComponent{{}, {}, static_cast<double>(src), false});
+        }
+        commands.Playback(registry);
+        std::vector<double> masses;
+        for (ednms::EntityID id = 1; id <= 6; ++id) {
+            masses.push_back(registry.GetComponent<ednms::PhysicsComponent>(id)->mass);
+        }
+        return masses;
+    };
+    const std::vector<double> a = run(false);
+    const std::vector<double> b = run(true);
+    EXPECT_TRUE(a == b);
+    EXPECT_NEAR(a[0], 1.0, 1e-12);
+    EXPECT_NEAR(a[5], 6.0, 1e-12);
+    return true;
+}
+
+TEST(CommandBuffer, RecordFromWorkerThreads) {
+    ednms::ECSRegistry registry;
+    std::vector<ednms::EntityID> sources;
+    for (int i = 0; i < 64; ++i) {
+        ednms::EntityID e = registry.CreateEntity();
+        registry.AddComponent(e, ednms::TransformComponent{{static_cast<double>(i), 0.0, 0.0}, {}});
+        sources.push_back(e);
+    }
+
+    const size_t workers = 4;
+    ednms::CommandBufferSet commands(workers);
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back([&, w]() {
+            const ednms::ECSRegistry& view = registry;
+            ednms::CommandBuffer& cb = commands.ForWorker(w);
+            for (size_t i = w; i < sources.size(); i += workers) {
+                // Each source fires a projectile from its position.
+                cb.SetSortKey(sources[i]);
+                const auto* from = view.GetComponent<ednms::TransformComponent>(sources[i]);
+                ednms::EntityID shot = cb.CreateEntity();
+                cb.AddComponent(shot, ednms::TransformComponent{from->position, {}});
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    commands.Playback(registry);
+    EXPECT_EQ(registry.EntityCount(), 128u);
+    // Projectiles are numbered in source order regardless of worker.
+    for (ednms::EntityID id = 65; id <= 128; ++id) {
+        EXPECT_NEAR(registry.GetComponent<ednms::TransformComponent>(id)->position.x,
+                    static_cast<double>(id - 65), 1e-12);
+    }
+    return true;
+}
+
+TEST(CommandBuffer, PayloadsInFrameArena) {
+    ednms::FrameArena arena(4096);
+    ednms::ECSRegistry registry;
+    ednms::CommandBufferSet commands({&arena});
+    ednms::CommandBuffer& cb = commands.ForWorker(0);
+    ednms::EntityID e = cb.CreateEntity();
+    cb.AddComponent(e, ednms::InventoryComponent{{{1, 10}, {2, 20}}});
+    EXPECT_GT(arena.BytesUsed(), 0u);
+
+    // Playback destroys the payloads; only then may the arena rewind.
+    commands.Playback(registry);
+    arena.Reset();
+    auto* inv = registry.GetComponent<ednms::InventoryComponent>(commands.Resolve(e));
+    EXPECT_TRUE(inv != nullptr);
+    EXPECT_EQ(inv->slots.size(), 2u);
+    return true;
+}
+
+TEST(CommandBuffer, PerWorkerArenasFromThreads) {
+    const size_t workers = 4;
+    std::vector<std::unique_ptr<ednms::FrameArena>> arenas;
+    std::vector<std::pmr::memory_resource*> resources;
+    for (size_t w = 0; w < workers; ++w) {
+        // Small blocks so workers keep hitting the arena's slow path concurrently.
+        arenas.push_back(std::make_unique<ednms::FrameArena>(1024));
+        resources.push_back(arenas.back().get());
+    }
+    ednms::FrameArena playbackArena;
+    ednms::CommandBufferSet commands(resources, &playbackArena);
+    ednms::ECSRegistry registry;
+
+    for (int tick = 0; tick < 3; ++tick) {
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&, w]() {
+                ednms::CommandBuffer& cb = commands.ForWorker(w);
+                for (uint64_t i = w; i < 400; i += workers) {
+                    cb.SetSortKey(i);
+                    ednms::EntityID e = cb.CreateEntity();
+                    const auto item = static_cast<uint32_t>(i);
+                    cb.AddComponent(e, ednms::InventoryComponent{{{item, item * 2}}});
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+        for (const auto& arena : arenas) EXPECT_GT(arena->BytesUsed(), 0u);
+
+        const size_t before = registry.EntityCount();
+        commands.Playback(registry);
+        for (const auto& arena : arenas) arena->Reset();
+        playbackArena.Reset();
+
+        EXPECT_EQ(registry.EntityCount(), before + 400);
+        for (uint32_t i = 0; i < 400; ++i) {
+            const auto id = static_cast<ednms::EntityID>(before + 1 + i);
+            const auto* inv = registry.GetComponent<ednms::InventoryComponent>(id);
+            EXPECT_TRUE(inv != nullptr);
+            EXPECT_EQ(inv->slots[0].type, i);
+            EXPECT_EQ(inv->slots[0].quantity, i * 2);
+        }
+    }
+    return true;
+}
+
+TEST(CommandBuffer, ClearResetsSortKey) {
+    ednms::ECSRegistry registry;
+    ednms::CommandBufferSet commands(2);
+    commands.ForWorker(0).SetSortKey(100);
+    commands.ForWorker(0).CreateEntity();
+    commands.Playback(registry);
+
+    // Next phase worker 0 forgets SetSortKey: it sorts under 0, not 100.
+    ednms::EntityID stale = commands.ForWorker(0).CreateEntity();
+    commands.ForWorker(1).SetSortKey(5);
+    ednms::EntityID keyed = commands.ForWorker(1).CreateEntity();
+    commands.Playback(registry);
+    EXPECT_TRUE(commands.Resolve(stale) < commands.Resolve(keyed));
+    return true;
+}
@@ -1,6 +1,7 @@
 #include "test_framework.h"
 #include "Engine/ECS/ecs_registry.h"
 #include "Engine/ECS/components.h"
+#include <type_traits>
 
 TEST(Components, TransformDefault) {
     ednms::TransformComponent t;
@@ -66,3 +67,97 @@ TEST(Components, OwnershipDefault) {
     EXPECT_EQ(o.accessMask, 0u);
     return true;
 }
+
+TEST(Components, StableTypeIDs) {
+    static_assert(ednms::ComponentID<ednms::TransformComponent>() == 0, "Transform ID is persisted");
+    static_assert(ednms::ComponentID<ednms::DockingComponent>() == 7, "Docking ID is persisted");
+    static_assert(ednms::ComponentID<ednms::LocalTransformComponent>() == 9, "LocalTransform ID is persisted");
+    EXPECT_EQ(ednms::ComponentID<ednms::PowerComponent>(), 3u);
+    return true;
+}
+
+TEST(Components, InfoTable) {
+    constexpr const ednms::ComponentInfo& power =
+        ednms::COMPONENT_INFO[ednms::ComponentID<ednms::PowerComponent>()];
+    static_assert(power.size == sizeof(ednms::PowerComponent), "size recorded at compile time");
+    EXPECT_TRUE(power.triviallyCopyable);
+    EXPECT_TRUE(power.serialize != nullptr);
+    EXPECT_EQ(std::string(power.name), std::string("PowerComponent"));
+
+    const ednms::ComponentInfo& inventory =
+        ednms::GetComponentInfo(ednms::ComponentID<ednms::InventoryComponent>());
+    EXPECT_FALSE(inventory.triviallyCopyable);
+    EXPECT_TRUE(inventory.serialize == nullptr);
+    EXPECT_FALSE(ednms::GetComponentInfo(200).IsValid());
+    EXPECT_FALSE(ednms::GetComponentInfo(300).IsValid());
+    EXPECT_FALSE(ednms::GetComponentInfo(ednms::INVALID_COMPONENT_TYPE).IsValid());
+    return true;
+}
+
+TEST(Components, IdClaimsMapBackToType) {
+    static_assert(std::is_same_v<ednms::ComponentIdClaim<8>::type, ednms::ParentComponent>,
+                  "every registered ID is claimed by exactly one type");
+    static_assert(std::is_same_v<ednms::ComponentIdClaim<0>::type, ednms::TransformComponent>,
+                  "every registered ID is claimed by exactly one type");
+    return true;
+}
+
+TEST(Components, TypedPoolPointersStayValid) {
+    ednms::ECSRegistry registry;
+    ednms::EntityID first = registry.CreateEntity();
+    registry.AddComponent(first, ednms::InventoryComponent{{{1, 5}}});
+    ednms::InventoryComponent* inv = registry.GetComponent<ednms::InventoryComponent>(first);
+    for (int i = 0; i < 1000; ++i) {
+        registry.AddComponent(registry.CreateEntity(), ednms::InventoryComponent{});
+    }
+    EXPECT_TRUE(inv == registry.GetComponent<ednms::InventoryComponent>(first));
+    EXPECT_EQ(inv->slots[0].quantity, 5u);
+    registry.DestroyEntity(first);
+    EXPECT_EQ(registry.EntityCount(), 1000u);
+    return true;
+}
+
+TEST(Components, TrivialSerializerRoundTrip) {
+    ednms::PowerComponent in{250.0f, 100.0f, true};
+    const ednms::ComponentInfo& info = ednms::GetComponentInfo(ednms::ComponentID<ednms::PowerComponent>());
+    std::vector<uint8_t> bytes;
+    info.serialize(&in, bytes);
+    EXPECT_EQ(bytes.size(), sizeof(ednms::PowerComponent));
+
+    ednms::PowerComponent out;
+    EXPECT_TRUE(info.deserialize(&out, bytes.data(), bytes.size()));
+    EXPECT_NEAR(out.generated, 250.0f, 1e-5);
+    EXPECT_TRUE(out.powered);
+    return true;
+}
+
+TEST(Components, WideMaskMatching) {
+    ednms::ComponentMask mask;
+    mask.set(3).set(70).set(255);
+    EXPECT_EQ(mask.count(), 3u);
+    EXPECT_TRUE(mask.test(255));
+
+    ednms::ComponentMask required;
+    required.set(70).set(255);
+    EXPECT_TRUE(mask.Contains(required));
+    required.set(128);
+    EXPECT_FALSE(mask.Contains(required));
+    EXPECT_TRUE(mask.Intersects(required));
+
+    std::vector<size_t> bits;
+    mask.ForEachSetBit([&](size_t bit) { bits.push_back(bit); });
+    EXPECT_EQ(bits.size(), 3u);
+    EXPECT_EQ(bits[1], 70u);
+    return true;
+}
+
+TEST(Components, RegistryMaskOf) {
+    ednms::ECSRegistry registry;
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AddComponent(e, ednms::TransformComponent{});
+    registry.AddComponent(e, ednms::DockingComponent{});
+    EXPECT_TRUE(registry.GetMask(e) ==
+        (ednms::ECSRegistry::MaskOf<ednms::TransformComponent, ednms::DockingComponent>()));
+    EXPECT_EQ(registry.GetEntitiesWithMask(ednms::ECSRegistry::MaskOf<ednms::DockingComponent>()).size(), 1u);
+    return true;
+}
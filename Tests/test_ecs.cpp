@@ -82,3 +82,121 @@ TEST(ECS, DestroyRemovesComponents) {
     EXPECT_EQ(registry.EntityCount(), 0u);
     return true;
 }
+
+TEST(ECS, ChangeTrackingAddedAndChanged) {
+    ednms::ECSRegistry registry;
+    registry.EnableChangeTracking<ednms::PowerComponent>();
+
+    ednms::EntityID a = registry.CreateEntity();
+    ednms::EntityID b = registry.CreateEntity();
+    registry.AddComponent(a, ednms::PowerComponent{});
+    registry.AddComponent(b, ednms::PowerComponent{});
+    const uint64_t seen = registry.ObserveChanges();
+
+    registry.AdvanceTick();
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(seen).size(), 0u);
+    EXPECT_EQ(registry.GetAddedSince<ednms::PowerComponent>(seen).size(), 0u);
+
+    registry.GetComponent<ednms::PowerComponent>(b)->generated = 5.0f;
+    auto changed = registry.GetChangedSince<ednms::PowerComponent>(seen);
+    EXPECT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], b);
+    EXPECT_EQ(registry.GetChangedTick<ednms::PowerComponent>(b), registry.CurrentTick());
+    return true;
+}
+
+TEST(ECS, ChangeTrackingConstAccessDoesNotMark) {
+    ednms::ECSRegistry registry;
+    registry.EnableChangeTracking<ednms::PowerComponent>();
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AddComponent(e, ednms::PowerComponent{});
+    const uint64_t seen = registry.ObserveChanges();
+
+    registry.AdvanceTick();
+    const ednms::ECSRegistry& view = registry;
+    EXPECT_TRUE(view.GetComponent<ednms::PowerComponent>(e) != nullptr);
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(seen).size(), 0u);
+
+    registry.MarkChanged<ednms::PowerComponent>(e);
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(seen).size(), 1u);
+    return true;
+}
+
+TEST(ECS, ChangeTrackingRemoved) {
+    ednms::ECSRegistry registry;
+    registry.EnableChangeTracking<ednms::PowerComponent>();
+    ednms::EntityID a = registry.CreateEntity();
+    ednms::EntityID b = registry.CreateEntity();
+    registry.AddComponent(a, ednms::PowerComponent{});
+    registry.AddComponent(b, ednms::PowerComponent{});
+    const uint64_t seen = registry.ObserveChanges();
+
+    registry.AdvanceTick();
+    registry.RemoveComponent<ednms::PowerComponent>(a);
+    registry.DestroyEntity(b);
+
+    auto removed = registry.GetRemovedSince<ednms::PowerComponent>(seen);
+    EXPECT_EQ(removed.size(), 2u);
+    EXPECT_EQ(removed[0], a);
+    EXPECT_EQ(removed[1], b);
+    // Removed components no longer show up as changed.
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(0).size(), 0u);
+    return true;
+}
+
+TEST(ECS, ChangeTrackingTrimHistory) {
+    ednms::ECSRegistry registry;
+    registry.EnableChangeTracking<ednms::PowerComponent>();
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AdvanceTick();
+    registry.AddComponent(e, ednms::PowerComponent{});
+    EXPECT_EQ(registry.GetAddedSince<ednms::PowerComponent>(0).size(), 1u);
+
+    registry.EnableChangeTracking<ednms::TransformComponent>();
+    registry.AddComponent(e, ednms::TransformComponent{});
+
+    // Per-type trimming leaves other consumers' pools alone.
+    const uint64_t seen = registry.ObserveChanges();
+    registry.TrimChangeHistory<ednms::PowerComponent>(seen);
+    EXPECT_EQ(registry.GetAddedSince<ednms::PowerComponent>(0).size(), 0u);
+    EXPECT_EQ(registry.GetAddedSince<ednms::TransformComponent>(0).size(), 1u);
+
+    registry.TrimAllChangeHistory(seen);
+    EXPECT_EQ(registry.GetAddedSince<ednms::TransformComponent>(0).size(), 0u);
+    return true;
+}
+
+TEST(ECS, ChangeTrackingSeesWritesLaterInSameTick) {
+    ednms::ECSRegistry registry;
+    registry.EnableChangeTracking<ednms::PowerComponent>();
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AdvanceTick();
+    registry.AddComponent(e, ednms::PowerComponent{});
+
+    // A consumer runs, writes, and closes its window...
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(0).size(), 1u);
+    registry.GetComponent<ednms::PowerComponent>(e)->powered = true;
+    const uint64_t seen = registry.ObserveChanges();
+    EXPECT_EQ(registry.GetChangedSince<ednms::PowerComponent>(seen).size(), 0u);
+
+    // ...then another system writes in the same tick: it must not be lost.
+    registry.GetComponent<ednms::PowerComponent>(e)->generated = 10.0f;
+    registry.AdvanceTick();
+    auto changed = registry.GetChangedSince<ednms::PowerComponent>(seen);
+    EXPECT_EQ(changed.size(), 1u);
+    EXPECT_EQ(changed[0], e);
+    EXPECT_EQ(registry.GetChangedTick<ednms::PowerComponent>(e), 1u);
+    return true;
+}
+
+TEST(ECS, ChangeTrackingIsOptIn) {
+    ednms::ECSRegistry registry;
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AddComponent(e, ednms::SurvivalComponent{});
+    registry.AdvanceTick();
+    registry.GetComponent<ednms::SurvivalComponent>(e)->oxygen = 50.0f;
+    EXPECT_FALSE(registry.IsChangeTracked<ednms::SurvivalComponent>());
+    EXPECT_EQ(registry.GetChangedSince<ednms::SurvivalComponent>(0).size(), 0u);
+    EXPECT_EQ(registry.GetChangedTick<ednms::SurvivalComponent>(e), 1u);
+    return true;
+}
@@ -0,0 +1,49 @@
+#include "test_framework.h"
+#include "Engine/Core/FixedTimestep.h"
+
+TEST(FixedTimestep, TickDurationFromRate) {
+    ednms::FixedTimestep step({50.0, 5, ednms::OverloadPolicy::DropTicks});
+    EXPECT_NEAR(step.TickDuration(), 0.02, 1e-12);
+    return true;
+}
+
+TEST(FixedTimestep, AccumulatesPartialFrames) {
+    ednms::FixedTimestep step({4.0, 5, ednms::OverloadPolicy::DropTicks});
+    EXPECT_EQ(step.Advance(0.125), 0u);
+    EXPECT_EQ(step.Advance(0.1875), 1u);
+    EXPECT_NEAR(step.Alpha(), 0.25, 1e-9);
+    EXPECT_EQ(step.CurrentTick(), 1u);
+    return true;
+}
+
+TEST(FixedTimestep, CatchUpIsCapped) {
+    ednms::FixedTimestep step({8.0, 3, ednms::OverloadPolicy::DropTicks});
+    EXPECT_EQ(step.Advance(1.0), 3u);
+    EXPECT_EQ(step.DroppedTicks(), 5u);
+    EXPECT_EQ(step.OverloadedFrames(), 1u);
+    EXPECT_EQ(step.Advance(0.0), 0u);
+    return true;
+}
+
+TEST(FixedTimestep, CarryDebtKeepsBacklog) {
+    ednms::FixedTimestep step({8.0, 3, ednms::OverloadPolicy::CarryDebt});
+    EXPECT_EQ(step.Advance(1.0), 3u);
+    EXPECT_EQ(step.DroppedTicks(), 0u);
+    EXPECT_EQ(step.Advance(0.0), 3u);
+    EXPECT_EQ(step.Advance(0.0), 2u);
+    EXPECT_EQ(step.Advance(0.0), 0u);
+    EXPECT_EQ(step.CurrentTick(), 8u);
+    return true;
+}
+
+TEST(FixedTimestep, TimingStats) {
+    ednms::TickTimingStats stats;
+    stats.Record(0.010, 0.016);
+    stats.Record(0.020, 0.016);
+    EXPECT_EQ(stats.samples, 2u);
+    EXPECT_NEAR(stats.Mean(), 0.015, 1e-12);
+    EXPECT_NEAR(stats.min, 0.010, 1e-12);
+    EXPECT_NEAR(stats.max, 0.020, 1e-12);
+    EXPECT_EQ(stats.overBudget, 1u);
+    return true;
+}
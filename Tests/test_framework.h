@@ -23,17 +23,28 @@ inline int RegisterTest(const std::string& name, std::function<bool()> func) {
     return 0;
 }
 
+// Set by SKIP_TEST; a skipped test is reported but counts neither way.
+inline std::string& SkipReason() {
+    static std::string reason;
+    return reason;
+}
+
 inline int RunAllTests() {
     int passed = 0;
     int failed = 0;
+    int skipped = 0;
     for (const auto& tc : GetTests()) {
         bool ok = false;
+        SkipReason().clear();
         try {
             ok = tc.func();
         } catch (const std::exception& e) {
             std::cerr << "  EXCEPTION: " << e.what() << std::endl;
         }
-        if (ok) {
+        if (ok && !SkipReason().empty()) {
+            std::cout << "  SKIP: " << tc.name << " (" << SkipReason() << ")" << std::endl;
+            ++skipped;
+        } else if (ok) {
             std::cout << "  PASS: " << tc.name << std::endl;
             ++passed;
         } else {
@@ -41,8 +52,9 @@ inline int RunAllTests() {
             ++failed;
         }
     }
-    std::cout << std::endl << passed << " passed, " << failed << " failed, "
-              << (passed + failed) << " total" << std::endl;
+    std::cout << std::endl << passed << " passed, " << failed << " failed, ";
+    if (skipped > 0) std::cout << skipped << " skipped, ";
+    std::cout << (passed + failed + skipped) << " total" << std::endl;
     return failed > 0 ? 1 : 0;
 }
 
@@ -51,6 +63,8 @@ inline int RunAllTests() {
     static int suite##_##name##_reg = test::RegisterTest(#suite "." #name, suite##_##name); \
     static bool suite##_##name()
 
+#define SKIP_TEST(reason) do { test::SkipReason() = (reason); return true; } while(0)
+
 #define EXPECT_TRUE(expr) do { if (!(expr)) { std::cerr << "    Expected true: " #expr << std::endl; return false; } } while(0)
 #define EXPECT_FALSE(expr) do { if ((expr)) { std::cerr << "    Expected false: " #expr << std::endl; return false; } } while(0)
 #define EXPECT_EQ(a, b) do { if ((a) != (b)) { std::cerr << "    Expected equal: " #a " == " #b << std::endl; return false; } } while(0)
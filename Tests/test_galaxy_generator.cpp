@@ -0,0 +1,230 @@
+#include "test_framework.h"
+#include "Simulation/Generation/CounterRng.h"
+#include "Simulation/Generation/DetMath.h"
+#include "Simulation/Generation/GalaxyGenerator.h"
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// A sector near the Sun's galactic radius, in the disc plane.
+const ednms::ChunkCoord SOLAR_SECTOR{2600, 0, 0};
+
+bool SameSummary(const ednms::StarSystemSummary& a, const ednms::StarSystemSummary& b) {
+    return a.systemId == b.systemId && a.x == b.x && a.y == b.y && a.z == b.z
+        && a.starClass == b.starClass && a.planetCount == b.planetCount;
+}
+
+constexpr uint32_t GOLDEN_SYSTEMS = 208;
+constexpr uint64_t GOLDEN_SECTOR_HASH = 0xECE67AE7F0C4550Aull;
+constexpr uint64_t GOLDEN_SYSTEM_HASH = 0x9B1B7CE5149A6307ull;
+
+// FNV-1a over the exact bit patterns of generated output.
+struct BitHash {
+    uint64_t value = 0xCBF29CE484222325ull;
+
+    template<typename T>
+    void Add(const T& v) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        for (unsigned char b : bytes) value = (value ^ b) * 0x100000001B3ull;
+    }
+};
+
+} // namespace
+
+TEST(CounterRng, PureFunctionOfKeyAndCounter) {
+    ednms::CounterRng a(42);
+    ednms::CounterRng b(42);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(a.NextU64(), b.NextU64());
+
+    ednms::CounterRng skip(42, 50);
+    EXPECT_EQ(skip.NextU64(), ednms::CounterHash(42, 50));
+    EXPECT_NE(ednms::CounterHash(42, 0), ednms::CounterHash(43, 0));
+
+    ednms::CounterRng r(7);
+    for (int i = 0; i < 1000; ++i) {
+        const double d = r.NextDouble();
+        EXPECT_TRUE(d >= 0.0 && d < 1.0);
+        EXPECT_TRUE(r.NextBelow(10) < 10u);
+    }
+    return true;
+}
+
+TEST(GalaxyGenerator, SystemIdRoundTrip) {
+    const ednms::ChunkCoord sector{-12345, -7, 4321};
+    const uint64_t id = ednms::MakeSystemId(sector, 99);
+    const ednms::ChunkCoord back = ednms::SystemSector(id);
+    EXPECT_EQ(back.x, sector.x);
+    EXPECT_EQ(back.y, sector.y);
+    EXPECT_EQ(back.z, sector.z);
+    EXPECT_EQ(ednms::SystemIndex(id), 99u);
+    return true;
+}
+
+TEST(GalaxyGenerator, DeterministicAcrossInstances) {
+    ednms::GalaxyGenerator a;
+    ednms::GalaxyGenerator b;
+    const ednms::SectorContent sa = a.GenerateSector(SOLAR_SECTOR);
+    const ednms::SectorContent sb = b.GenerateSector(SOLAR_SECTOR);
+    EXPECT_EQ(sa.systems.size(), sb.systems.size());
+    for (size_t i = 0; i < sa.systems.size(); ++i) {
+        EXPECT_TRUE(SameSummary(sa.systems[i], sb.systems[i]));
+    }
+    return true;
+}
+
+TEST(GalaxyGenerator, SystemsGenerateIndependently) {
+    ednms::GalaxyGenerator gen;
+    // Find a populated sector along the disc.
+    ednms::SectorContent sector;
+    for (int32_t x = 2600; sector.systems.empty() && x < 2700; ++x) {
+        sector = gen.GenerateSector({x, 0, 0});
+    }
+    EXPECT_FALSE(sector.systems.empty());
+
+    for (const ednms::StarSystemSummary& summary : sector.systems) {
+        const ednms::StarSystem system = gen.GenerateSystem(summary.systemId);
+        EXPECT_TRUE(SameSummary(system.summary, summary));
+        EXPECT_EQ(system.planets.size(), summary.planetCount);
+        // Positions fall inside the owning sector.
+        EXPECT_TRUE(summary.x >= sector.coord.x * 10.0 && summary.x < (sector.coord.x + 1) * 10.0);
+    }
+    return true;
+}
+
+TEST(GalaxyGenerator, SeedChangesGalaxy) {
+    ednms::GalaxyConfig other;
+    other.galaxySeed = 1234;
+    ednms::GalaxyGenerator a;
+    ednms::GalaxyGenerator b(other);
+
+    // Central sectors are dense enough that identical output would be a bug.
+    const ednms::SectorContent sa = a.GenerateSector({0, 0, 0});
+    const ednms::SectorContent sb = b.GenerateSector({0, 0, 0});
+    EXPECT_GT(sa.systems.size(), 0u);
+    EXPECT_GT(sb.systems.size(), 0u);
+    EXPECT_TRUE(sa.systems[0].x != sb.systems[0].x || sa.systems.size() != sb.systems.size());
+    return true;
+}
+
+TEST(GalaxyGenerator, DensityModel) {
+    ednms::GalaxyGenerator gen;
+    EXPECT_GT(gen.ExpectedStarCount({0, 0, 0}), gen.ExpectedStarCount(SOLAR_SECTOR));
+    EXPECT_GT(gen.ExpectedStarCount(SOLAR_SECTOR), gen.ExpectedStarCount({2600, 300, 0}));
+    EXPECT_NEAR(gen.ExpectedStarCount({6000, 0, 0}), 0.0, 1e-12);
+    EXPECT_EQ(gen.GenerateSector({6000, 0, 0}).systems.size(), 0u);
+    return true;
+}
+
+TEST(GalaxyCache, HitsAndEvictsLeastRecentlyUsed) {
+    ednms::GalaxyGenerator gen;
+    ednms::GalaxyCache cache(gen, 2);
+
+    auto first = cache.GetSector({0, 0, 0});
+    cache.GetSector({1, 0, 0});
+    EXPECT_TRUE(cache.GetSector({0, 0, 0}) == first);   // hit, now most recent
+    cache.GetSector({2, 0, 0});                          // evicts {1,0,0}
+
+    const ednms::GalaxyCacheStats stats = cache.Stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(cache.Size(), 2u);
+
+    cache.GetSector({0, 0, 0});
+    EXPECT_EQ(cache.Stats().hits, 2u);
+    cache.GetSector({1, 0, 0});
+    EXPECT_EQ(cache.Stats().misses, 4u);
+    return true;
+}
+
+TEST(DetMath, ExpMatchesLibm) {
+    EXPECT_EQ(ednms::DetExp(0.0), 1.0);
+    EXPECT_EQ(ednms::DetExp(-800.0), 0.0);
+    EXPECT_TRUE(std::isinf(ednms::DetExp(800.0)));
+    for (double x = -700.0; x < 700.0; x += 0.37) {
+        const double ref = std::exp(x);
+        EXPECT_NEAR(ednms::DetExp(x) / ref, 1.0, 4e-16);
+    }
+    return true;
+}
+
+TEST(GalaxyGenerator, StarCountsFollowDensity) {
+    ednms::GalaxyGenerator gen;
+    // Dense central sectors (lambda ~ 100) summed over many draws.
+    double expected = 0.0;
+    double observed = 0.0;
+    for (int32_t x = 0; x < 200; ++x) {
+        expected += gen.ExpectedStarCount({x, 0, 0});
+        observed += static_cast<double>(gen.GenerateSector({x, 0, 0}).systems.size());
+    }
+    EXPECT_NEAR(observed, expected, 4.0 * std::sqrt(expected));
+
+    // Means beyond one inversion piece go through the split path.
+    ednms::GalaxyConfig dense;
+    dense.localDensity = 1.0;
+    ednms::GalaxyGenerator packed(dense);
+    expected = 0.0;
+    observed = 0.0;
+    for (int32_t x = 0; x < 20; ++x) {
+        expected += packed.ExpectedStarCount({x, 0, 0});
+        observed += static_cast<double>(packed.GenerateSector({x, 0, 0}).systems.size());
+    }
+    EXPECT_GT(expected / 20.0, 1000.0);
+    EXPECT_NEAR(observed, expected, 4.0 * std::sqrt(expected));
+    return true;
+}
+
+// Golden values: any change here means existing galaxies regenerate
+// differently (and saved deltas no longer line up). Do not update casually.
+TEST(GalaxyGenerator, GoldenOutput) {
+    ednms::GalaxyGenerator gen;
+    BitHash sectors;
+    uint32_t systems = 0;
+    for (const ednms::ChunkCoord& c : {ednms::ChunkCoord{0, 0, 0}, SOLAR_SECTOR,
+                                       ednms::ChunkCoord{-1234, 3, 777}, ednms::ChunkCoord{10, -40, -10}}) {
+        for (const ednms::StarSystemSummary& s : gen.GenerateSector(c).systems) {
+            sectors.Add(s.systemId);
+            sectors.Add(s.x);
+            sectors.Add(s.y);
+            sectors.Add(s.z);
+            sectors.Add(s.starClass);
+            sectors.Add(s.planetCount);
+            ++systems;
+        }
+    }
+    EXPECT_EQ(systems, GOLDEN_SYSTEMS);
+    EXPECT_EQ(sectors.value, GOLDEN_SECTOR_HASH);
+
+    BitHash detail;
+    const ednms::SectorContent centre = gen.GenerateSector({0, 0, 0});
+    for (size_t i = 0; i < centre.systems.size(); i += 7) {
+        const ednms::StarSystem system = gen.GenerateSystem(centre.systems[i].systemId);
+        detail.Add(system.starMass);
+        for (const ednms::PlanetInfo& p : system.planets) {
+            detail.Add(p.planetId);
+            detail.Add(p.orbitRadiusAU);
+            detail.Add(p.radiusKm);
+            detail.Add(p.gravity);
+            detail.Add(p.hasAtmosphere);
+            detail.Add(p.hasWater);
+        }
+    }
+    EXPECT_EQ(detail.value, GOLDEN_SYSTEM_HASH);
+    return true;
+}
+
+TEST(GalaxyCache, DistantSectorsDoNotCollide) {
+    ednms::GalaxyGenerator gen;
+    ednms::GalaxyCache cache(gen, 8);
+    // Coordinates that agree in their low 21 bits on every axis.
+    const ednms::ChunkCoord a{0, 0, 0};
+    const ednms::ChunkCoord b{1 << 21, -(1 << 21), 1 << 22};
+    EXPECT_EQ(cache.GetSector(a)->coord.x, 0);
+    auto far = cache.GetSector(b);
+    EXPECT_TRUE(far->coord == b);
+    EXPECT_EQ(cache.Stats().misses, 2u);
+    EXPECT_EQ(cache.Size(), 2u);
+    return true;
+}
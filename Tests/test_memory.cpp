@@ -0,0 +1,167 @@
+#include "test_framework.h"
+#include "Engine/Memory/AllocationCounters.h"
+#include "Engine/Memory/FrameArena.h"
+#include "Engine/Memory/ObjectPool.h"
+#include "Engine/ECS/ecs_command_buffer.h"
+#include "Engine/ECS/ecs_registry.h"
+#include "Engine/ECS/components.h"
+#include "Engine/Core/Log.h"
+#include <cstdint>
+#include <utility>
+
+// The zero-allocation checks need the global operator new hooks; when the
+// build links them (EDNMS_COUNT_HEAP_ALLOCATIONS) they must be active.
+#ifdef EDNMS_COUNT_HEAP_ALLOCATIONS
+#define REQUIRE_HEAP_HOOKS() EXPECT_TRUE(ednms::HeapAllocationCountingEnabled())
+#else
+#define REQUIRE_HEAP_HOOKS() SKIP_TEST("built without EDNMS_COUNT_HEAP_ALLOCATIONS")
+#endif
+
+TEST(FrameArena, AllocatesAligned) {
+    ednms::FrameArena arena(1024);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(16, 16);
+    EXPECT_TRUE(a != nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 16, 0u);
+    EXPECT_EQ(arena.BytesUsed(), 19u);
+    return true;
+}
+
+TEST(FrameArena, ResetReusesBlocks) {
+    ednms::FrameArena arena(256);
+    for (int frame = 0; frame < 4; ++frame) {
+        ednms::FrameVector<int> values(&arena);
+        for (int i = 0; i < 100; ++i) values.push_back(i);
+        arena.Reset();
+    }
+    const size_t blocks = arena.BlockCount();
+    EXPECT_GT(blocks, 0u);
+
+    ednms::ResetThreadAllocationCounters();
+    {
+        ednms::FrameVector<int> values(&arena);
+        for (int i = 0; i < 100; ++i) values.push_back(i);
+    }
+    arena.Reset();
+    EXPECT_EQ(arena.BlockCount(), blocks);
+    EXPECT_EQ(ednms::ThreadAllocationCounters().arenaOverflows, 0u);
+    EXPECT_GT(ednms::ThreadAllocationCounters().arenaAllocations, 0u);
+    return true;
+}
+
+TEST(FrameArena, OversizedAllocationGetsOwnBlock) {
+    ednms::FrameArena arena(128);
+    void* big = arena.allocate(4096, 8);
+    EXPECT_TRUE(big != nullptr);
+    EXPECT_GT(arena.Capacity(), 4095u);
+    return true;
+}
+
+TEST(ObjectPool, CreateDestroyRecycles) {
+    struct Debris { double mass; int id; };
+    ednms::ObjectPool<Debris, 4> pool;
+
+    Debris* a = pool.Create(Debris{10.0, 1});
+    Debris* b = pool.Create(Debris{20.0, 2});
+    EXPECT_EQ(pool.LiveCount(), 2u);
+    EXPECT_EQ(pool.Capacity(), 4u);
+    EXPECT_NEAR(b->mass, 20.0, 1e-12);
+
+    pool.Destroy(a);
+    Debris* c = pool.Create(Debris{30.0, 3});
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(pool.LiveCount(), 2u);
+
+    for (int i = 0; i < 3; ++i) pool.Create(Debris{0.0, i});
+    EXPECT_EQ(pool.Capacity(), 8u);
+    return true;
+}
+
+TEST(Memory, SteadyStateTickHasNoHeapAllocations) {
+    REQUIRE_HEAP_HOOKS();
+
+    ednms::ECSRegistry registry;
+    for (int i = 0; i < 256; ++i) {
+        ednms::EntityID e = registry.CreateEntity();
+        registry.AddComponent(e, ednms::TransformComponent{});
+        registry.AddComponent(e, ednms::PhysicsComponent{{1.0, 0.0, 0.0}, {}, 1.0, false});
+    }
+    constexpr ednms::ComponentMask moving =
+        ednms::ECSRegistry::MaskOf<ednms::TransformComponent, ednms::PhysicsComponent>();
+
+    ednms::FrameArena arena(4096);
+    auto tick = [&]() {
+        ednms::EntityList ids = registry.GetEntitiesWithMask(moving, &arena);
+        for (ednms::EntityID id : ids) {
+            auto* transform = registry.GetComponent<ednms::TransformComponent>(id);
+            const auto* physics = std::as_const(registry).GetComponent<ednms::PhysicsComponent>(id);
+            transform->position += physics->velocity * 0.016;
+        }
+    };
+
+    // Warm-up frame grows the arena to its high-water mark.
+    tick();
+    arena.Reset();
+
+    ednms::ResetThreadAllocationCounters();
+    for (int frame = 0; frame < 10; ++frame) {
+        tick();
+        arena.Reset();
+    }
+    EXPECT_EQ(ednms::ThreadAllocationCounters().heapAllocations, 0u);
+    EXPECT_EQ(ednms::ThreadAllocationCounters().arenaOverflows, 0u);
+    return true;
+}
+
+TEST(Memory, HeapCounterSeesAllocations) {
+    REQUIRE_HEAP_HOOKS();
+    ednms::ResetThreadAllocationCounters();
+    std::vector<int> values;
+    values.reserve(64);
+    EXPECT_GT(ednms::ThreadAllocationCounters().heapAllocations, 0u);
+    return true;
+}
+
+TEST(Memory, LogFormattingHasNoHeapAllocations) {
+    REQUIRE_HEAP_HOOKS();
+    ednms::ResetThreadAllocationCounters();
+    ednms::LogLine line;
+    line.AppendAll("[tick] ", uint64_t{42}, " | entities ", 1000u, " | ms ",
+                   ednms::LogFixed{1.23456, 3}, " | mass ", 1000.0, " | ok ", true);
+    EXPECT_EQ(ednms::ThreadAllocationCounters().heapAllocations, 0u);
+    EXPECT_TRUE(line.View() == "[tick] 42 | entities 1000 | ms 1.235 | mass 1000.000000 | ok true");
+    EXPECT_FALSE(line.Truncated());
+    return true;
+}
+
+TEST(Memory, CommandPlaybackReusesStorage) {
+    REQUIRE_HEAP_HOOKS();
+    ednms::ECSRegistry registry;
+    registry.ReserveEntities(1024);   // so each create costs exactly one map node
+    ednms::FrameArena workerA(4096);
+    ednms::FrameArena workerB(4096);
+    ednms::FrameArena playback(4096);
+    ednms::CommandBufferSet commands({&workerA, &workerB}, &playback);
+
+    // Steady state: beyond the registry's own node per entity, recording and
+    // playback stay in the arenas and the set's retained Resolve() table.
+    // The first phase warms them up.
+    const uint64_t createsPerPhase = 8;
+    for (int phase = 0; phase < 4; ++phase) {
+        if (phase == 1) ednms::ResetThreadAllocationCounters();
+        for (size_t w = 0; w < 2; ++w) {
+            ednms::CommandBuffer& cb = commands.ForWorker(w);
+            for (uint64_t i = 0; i < createsPerPhase / 2; ++i) {
+                cb.SetSortKey(w * 100 + i);
+                cb.CreateEntity();
+            }
+        }
+        EXPECT_EQ(commands.Playback(registry), createsPerPhase);
+        workerA.Reset();
+        workerB.Reset();
+        playback.Reset();
+    }
+    EXPECT_EQ(ednms::ThreadAllocationCounters().heapAllocations, 3 * createsPerPhase);
+    EXPECT_EQ(registry.EntityCount(), 4 * createsPerPhase);
+    return true;
+}
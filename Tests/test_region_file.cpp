@@ -0,0 +1,314 @@
+#include "test_framework.h"
+#include "Engine/IO/lz_codec.h"
+#include "Engine/IO/region_file.h"
+#include "Simulation/World/Chunk.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+
+// Fresh scratch directory per test, removed on scope exit.
+struct TempDir {
+    std::filesystem::path path;
+
+    explicit TempDir(const char* name) {
+        path = std::filesystem::temp_directory_path() / (std::string("ednms_") + name);
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+std::vector<uint8_t> MakeBlob(size_t size, uint32_t seed, bool compressible) {
+    std::vector<uint8_t> blob(size);
+    std::mt19937 rng(seed);
+    for (size_t i = 0; i < size; ++i) {
+        blob[i] = compressible ? static_cast<uint8_t>((i / 16) % 7) : static_cast<uint8_t>(rng());
+    }
+    return blob;
+}
+
+bool RoundTrip(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> packed;
+    ednms::lz::Compress(input.data(), input.size(), packed);
+    if (packed.size() > ednms::lz::CompressBound(input.size())) return false;
+    std::vector<uint8_t> unpacked(input.size());
+    return ednms::lz::Decompress(packed.data(), packed.size(), unpacked.data(), unpacked.size())
+        && unpacked == input;
+}
+
+// Raw access to one offset-table slot, for simulating crashes and corruption.
+constexpr std::streamoff EntryOffset(uint32_t index) {
+    return static_cast<std::streamoff>(sizeof(ednms::RegionFileHeader) + index * sizeof(ednms::RegionEntry));
+}
+
+ednms::RegionEntry ReadEntry(const std::string& path, uint32_t index) {
+    ednms::RegionEntry entry;
+    std::ifstream in(path, std::ios::binary);
+    in.seekg(EntryOffset(index));
+    in.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    return entry;
+}
+
+void WriteEntry(const std::string& path, uint32_t index, const ednms::RegionEntry& entry) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(EntryOffset(index));
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+}
+
+} // namespace
+
+TEST(LZCodec, RoundTrip) {
+    EXPECT_TRUE(RoundTrip({}));
+    EXPECT_TRUE(RoundTrip({1, 2, 3}));
+    EXPECT_TRUE(RoundTrip(MakeBlob(100000, 1, true)));
+    EXPECT_TRUE(RoundTrip(MakeBlob(100000, 2, false)));
+    EXPECT_TRUE(RoundTrip(std::vector<uint8_t>(70000, 0xAB)));
+    return true;
+}
+
+TEST(LZCodec, CompressesRepetitiveData) {
+    const std::vector<uint8_t> input = MakeBlob(64 * 1024, 3, true);
+    std::vector<uint8_t> packed;
+    ednms::lz::Compress(input.data(), input.size(), packed);
+    EXPECT_TRUE(packed.size() < input.size() / 4);
+    return true;
+}
+
+TEST(LZCodec, RejectsCorruptInput) {
+    const std::vector<uint8_t> input = MakeBlob(4096, 4, true);
+    std::vector<uint8_t> packed;
+    ednms::lz::Compress(input.data(), input.size(), packed);
+    std::vector<uint8_t> out(input.size());
+    EXPECT_FALSE(ednms::lz::Decompress(packed.data(), packed.size() / 2, out.data(), out.size()));
+    std::vector<uint8_t> small(input.size() - 1);
+    EXPECT_FALSE(ednms::lz::Decompress(packed.data(), packed.size(), small.data(), small.size()));
+    return true;
+}
+
+TEST(RegionFile, CoordMapping) {
+    const ednms::RegionCoord r = ednms::RegionCoordFor(-1, 31, 32);
+    EXPECT_EQ(r.x, -1);
+    EXPECT_EQ(r.y, 0);
+    EXPECT_EQ(r.z, 1);
+    EXPECT_EQ(ednms::RegionLocalIndex(-1, 31, 32), 31u + 31u * 32u);
+    EXPECT_EQ(ednms::RegionFileName({-1, 0, 2}), std::string("r.-1.0.2.region"));
+    return true;
+}
+
+TEST(RegionFile, WriteReadReopen) {
+    TempDir dir("region_rw");
+    const std::string path = (dir.path / "r.0.0.0.region").string();
+    const auto terrain = MakeBlob(20000, 5, true);
+    const auto noise = MakeBlob(5000, 6, false);
+
+    {
+        ednms::RegionFile region;
+        EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{1, 2, 3}, terrain));
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{31, 31, 31}, noise));
+        EXPECT_FALSE(region.WriteChunk(ednms::ChunkCoord{32, 0, 0}, noise));   // other region
+    }
+
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{1, 2, 3}, out));
+    EXPECT_TRUE(out == terrain);
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{31, 31, 31}, out));
+    EXPECT_TRUE(out == noise);
+    EXPECT_FALSE(region.HasChunk(0, 0, 0));
+
+    const ednms::RegionStats stats = region.Stats();
+    EXPECT_EQ(stats.chunkCount, 2u);
+    EXPECT_TRUE(stats.storedBytes < stats.rawBytes);
+
+    ednms::RegionFile wrongRegion;
+    EXPECT_FALSE(wrongRegion.Open(path, {1, 0, 0}));
+    return true;
+}
+
+TEST(RegionFile, CompactReclaimsFreeSectors) {
+    TempDir dir("region_compact");
+    const std::string path = (dir.path / "r.0.0.0.region").string();
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+
+    for (int32_t i = 0; i < 8; ++i) {
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{i, 0, 0}, MakeBlob(9000, i, false)));
+    }
+    // Grow one chunk (moves it) and erase another: both leave holes.
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{2, 0, 0}, MakeBlob(20000, 42, false)));
+    EXPECT_TRUE(region.EraseChunk(5, 0, 0));
+    EXPECT_GT(region.Stats().freeSectors, 0u);
+    const uint32_t before = region.Stats().totalSectors;
+
+    EXPECT_TRUE(region.Compact());
+    EXPECT_EQ(region.Stats().freeSectors, 0u);
+    EXPECT_TRUE(region.Stats().totalSectors < before);
+    EXPECT_EQ(region.Stats().chunkCount, 7u);
+
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(region.ReadChunk(2, 0, 0, out));
+    EXPECT_TRUE(out == MakeBlob(20000, 42, false));
+    EXPECT_TRUE(region.ReadChunk(7, 0, 0, out));
+    EXPECT_TRUE(out == MakeBlob(9000, 7, false));
+    EXPECT_FALSE(region.ReadChunk(5, 0, 0, out));
+    return true;
+}
+
+TEST(RegionFile, FailedCompactKeepsRegionOpen) {
+    TempDir dir("region_compact_fail");
+    const std::string path = (dir.path / "r.0.0.0.region").string();
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+    const auto first = MakeBlob(9000, 1, false);
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, first));
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{1, 0, 0}, MakeBlob(9000, 2, false)));
+
+    // Cut the second blob off behind the region's back: copying it fails.
+    const uint64_t size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 2 * ednms::REGION_SECTOR_SIZE);
+    EXPECT_FALSE(region.Compact());
+    EXPECT_FALSE(std::filesystem::exists(path + ".compact"));
+    EXPECT_TRUE(region.IsOpen());
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{0, 0, 0}, out));
+    EXPECT_TRUE(out == first);
+    return true;
+}
+
+TEST(RegionFile, RewriteReusesFreedSectors) {
+    TempDir dir("region_reuse");
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open((dir.path / "r.0.0.0.region").string(), {0, 0, 0}));
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, MakeBlob(10000, 1, false)));
+    const uint32_t total = region.Stats().totalSectors;
+    // The rewrite lands in a new sector; the three old ones are then free.
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, MakeBlob(3000, 2, false)));
+    EXPECT_EQ(region.Stats().totalSectors, total + 1);
+    EXPECT_EQ(region.Stats().freeSectors, 3u);
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{1, 0, 0}, MakeBlob(3000, 3, false)));
+    EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, MakeBlob(3000, 4, false)));
+    EXPECT_EQ(region.Stats().totalSectors, total + 1);
+    return true;
+}
+
+TEST(RegionFile, RewriteKeepsOldBlobUntilEntrySwitches) {
+    TempDir dir("region_rewrite");
+    const std::string path = (dir.path / "r.0.0.0.region").string();
+    const auto first = MakeBlob(5000, 1, false);
+    ednms::RegionEntry before;
+    {
+        ednms::RegionFile region;
+        EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, first));
+        before = ReadEntry(path, 0);
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, MakeBlob(4000, 2, false)));
+        EXPECT_TRUE(ReadEntry(path, 0).sector != before.sector);
+    }
+    // Simulate a crash before the table update: the old entry still reads back intact.
+    WriteEntry(path, 0, before);
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{0, 0, 0}, out));
+    EXPECT_TRUE(out == first);
+    return true;
+}
+
+TEST(RegionFile, DropsCorruptTableEntries) {
+    TempDir dir("region_corrupt");
+    const std::string path = (dir.path / "r.0.0.0.region").string();
+    const auto a = MakeBlob(5000, 1, false);
+    const auto b = MakeBlob(5000, 2, false);
+    {
+        ednms::RegionFile region;
+        EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, a));
+        EXPECT_TRUE(region.WriteChunk(ednms::ChunkCoord{1, 0, 0}, b));
+    }
+    const ednms::RegionEntry good = ReadEntry(path, 0);
+
+    ednms::RegionEntry huge = good;           // would resize the read buffer to 4 GiB
+    huge.rawSize = huge.storedSize = 0xFFFFFFF0u;
+    ednms::RegionEntry badCodec = good;
+    badCodec.codec = static_cast<ednms::BlobCodec>(7);
+    ednms::RegionEntry overlap = good;        // shares chunk 0's sectors
+    ednms::RegionEntry mismatched = good;     // raw blob whose sizes disagree
+    mismatched.rawSize += 1;
+    WriteEntry(path, 2, huge);
+    WriteEntry(path, 3, badCodec);
+    WriteEntry(path, 4, overlap);
+    WriteEntry(path, 5, mismatched);
+
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+    EXPECT_EQ(region.Stats().droppedEntries, 4u);
+    EXPECT_EQ(region.Stats().chunkCount, 2u);
+    for (int32_t x = 2; x <= 5; ++x) EXPECT_FALSE(region.HasChunk(x, 0, 0));
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{0, 0, 0}, out));
+    EXPECT_TRUE(out == a);
+    EXPECT_TRUE(region.ReadChunk(ednms::ChunkCoord{1, 0, 0}, out));
+    EXPECT_TRUE(out == b);
+
+    // Dropped entries were cleared on disk, so a reopen is clean.
+    region.Close();
+    EXPECT_TRUE(region.Open(path, {0, 0, 0}));
+    EXPECT_EQ(region.Stats().droppedEntries, 0u);
+    return true;
+}
+
+TEST(RegionFile, RejectsOversizedChunk) {
+    TempDir dir("region_oversized");
+    ednms::RegionFile region;
+    EXPECT_TRUE(region.Open((dir.path / "r.0.0.0.region").string(), {0, 0, 0}));
+    std::vector<uint8_t> big(ednms::REGION_MAX_CHUNK_BYTES + 1);
+    EXPECT_FALSE(region.WriteChunk(ednms::ChunkCoord{0, 0, 0}, big));
+    EXPECT_FALSE(region.HasChunk(0, 0, 0));
+    return true;
+}
+
+TEST(RegionStore, SpansRegions) {
+    TempDir dir("region_store");
+    ednms::RegionStore store(dir.path.string());
+    const auto a = MakeBlob(1000, 1, true);
+    const auto b = MakeBlob(1000, 2, false);
+    EXPECT_TRUE(store.WriteChunk(ednms::ChunkCoord{-5, 0, 0}, a));
+    EXPECT_TRUE(store.WriteChunk(ednms::ChunkCoord{40, 0, 0}, b));
+    EXPECT_EQ(store.OpenRegionCount(), 2u);
+
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(store.ReadChunk(ednms::ChunkCoord{-5, 0, 0}, out));
+    EXPECT_TRUE(out == a);
+    EXPECT_TRUE(store.ReadChunk(ednms::ChunkCoord{40, 0, 0}, out));
+    EXPECT_TRUE(out == b);
+    EXPECT_FALSE(store.ReadChunk(ednms::ChunkCoord{1000, 0, 0}, out));
+    EXPECT_TRUE(store.CompactAll());
+    return true;
+}
+
+TEST(RegionStore, ClosesLeastRecentlyUsedRegion) {
+    TempDir dir("region_store_lru");
+    ednms::RegionStore store(dir.path.string(), 2);
+    const auto blob = MakeBlob(1000, 1, true);
+    EXPECT_TRUE(store.WriteChunk(ednms::ChunkCoord{0, 0, 0}, blob));
+    EXPECT_TRUE(store.WriteChunk(ednms::ChunkCoord{32, 0, 0}, blob));
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(store.ReadChunk(ednms::ChunkCoord{0, 0, 0}, out));   // region 0 now most recent
+    EXPECT_TRUE(store.WriteChunk(ednms::ChunkCoord{64, 0, 0}, blob)); // evicts region 1
+    EXPECT_EQ(store.OpenRegionCount(), 2u);
+
+    // Evicted regions reopen transparently with their data intact.
+    for (int32_t x : {0, 32, 64}) {
+        EXPECT_TRUE(store.ReadChunk(ednms::ChunkCoord{x, 0, 0}, out));
+        EXPECT_TRUE(out == blob);
+        EXPECT_EQ(store.OpenRegionCount(), 2u);
+    }
+    return true;
+}
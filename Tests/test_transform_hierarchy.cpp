@@ -0,0 +1,290 @@
+#include "test_framework.h"
+#include "Engine/Scene/TransformHierarchy.h"
+#include <thread>
+#include <vector>
+
+namespace {
+
+const double HALF_SQRT2 = std::sqrt(0.5);
+
+// 90 degrees about +Y: maps +X to -Z.
+ednms::Quatd YawQuarterTurn() {
+    return {HALF_SQRT2, 0.0, HALF_SQRT2, 0.0};
+}
+
+ednms::EntityID SpawnRoot(ednms::ECSRegistry& registry, const ednms::Vec3d& position,
+                          const ednms::Quatd& rotation = ednms::Quatd::Identity()) {
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AddComponent(e, ednms::TransformComponent{position, rotation});
+    return e;
+}
+
+ednms::EntityID Attach(ednms::ECSRegistry& registry, ednms::EntityID parent, const ednms::Vec3d& offset,
+                       const ednms::Quatd& rotation = ednms::Quatd::Identity()) {
+    ednms::EntityID e = registry.CreateEntity();
+    registry.AddComponent(e, ednms::TransformComponent{});
+    registry.AddComponent(e, ednms::ParentComponent{parent});
+    registry.AddComponent(e, ednms::LocalTransformComponent{offset, rotation});
+    return e;
+}
+
+const ednms::Vec3d& WorldPos(const ednms::ECSRegistry& registry, ednms::EntityID e) {
+    return registry.GetComponent<ednms::TransformComponent>(e)->position;
+}
+
+} // namespace
+
+TEST(TransformHierarchy, ComposesParentFrames) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    registry.AdvanceTick();
+
+    ednms::EntityID carrier = SpawnRoot(registry, {100.0, 0.0, 0.0}, YawQuarterTurn());
+    ednms::EntityID hangar = Attach(registry, carrier, {10.0, 0.0, 0.0}, YawQuarterTurn());
+    ednms::EntityID fighter = Attach(registry, hangar, {1.0, 0.0, 0.0});
+    hierarchy.Update();
+
+    const ednms::ECSRegistry& view = registry;
+    // Hangar: carrier yaw turns +10x into -10z.
+    EXPECT_NEAR(WorldPos(view, hangar).x, 100.0, 1e-9);
+    EXPECT_NEAR(WorldPos(view, hangar).z, -10.0, 1e-9);
+    // Fighter: two quarter turns map +1x to -1x.
+    EXPECT_NEAR(WorldPos(view, fighter).x, 99.0, 1e-9);
+    EXPECT_NEAR(WorldPos(view, fighter).z, -10.0, 1e-9);
+    EXPECT_NEAR(view.GetComponent<ednms::TransformComponent>(fighter)->rotation.y, 1.0, 1e-9);
+
+    EXPECT_EQ(hierarchy.Stats().roots, 1u);
+    EXPECT_EQ(hierarchy.Stats().nodes, 3u);
+    EXPECT_EQ(hierarchy.Stats().maxDepth, 2u);
+    return true;
+}
+
+TEST(TransformHierarchy, OnlyDirtyTreesRecompute) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    registry.AdvanceTick();
+
+    ednms::EntityID a = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    ednms::EntityID b = SpawnRoot(registry, {0.0, 500.0, 0.0});
+    ednms::EntityID moduleA = Attach(registry, a, {0.0, 0.0, 5.0});
+    ednms::EntityID moduleB = Attach(registry, b, {0.0, 0.0, 5.0});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().dirtyRoots, 2u);
+
+    // Nothing moved: nothing recomputed.
+    registry.AdvanceTick();
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().dirtyRoots, 0u);
+    EXPECT_EQ(hierarchy.Stats().rebuilds, 1u);
+
+    // Moving root A only touches tree A.
+    registry.AdvanceTick();
+    registry.GetComponent<ednms::TransformComponent>(a)->position.x = 20.0;
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().dirtyRoots, 1u);
+    EXPECT_EQ(hierarchy.Stats().nodesUpdated, 1u);
+    EXPECT_NEAR(WorldPos(registry, moduleA).x, 20.0, 1e-12);
+    EXPECT_EQ(registry.GetChangedTick<ednms::TransformComponent>(moduleB), 1u);
+
+    // Editing a local transform dirties its tree too.
+    registry.AdvanceTick();
+    registry.GetComponent<ednms::LocalTransformComponent>(moduleB)->position.z = 7.0;
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().dirtyRoots, 1u);
+    EXPECT_NEAR(WorldPos(registry, moduleB).z, 7.0, 1e-12);
+    EXPECT_EQ(hierarchy.Stats().rebuilds, 1u);
+    return true;
+}
+
+TEST(TransformHierarchy, DockAndUndock) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    registry.AdvanceTick();
+
+    ednms::EntityID station = SpawnRoot(registry, {1000.0, 0.0, 0.0});
+    ednms::EntityID ship = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 0u);
+
+    // Docking: attach the ship to a pad on the station.
+    registry.AdvanceTick();
+    registry.AddComponent(ship, ednms::ParentComponent{station});
+    registry.AddComponent(ship, ednms::LocalTransformComponent{{0.0, 25.0, 0.0}, ednms::Quatd::Identity()});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().rebuilds, 2u);
+    EXPECT_NEAR(WorldPos(registry, ship).x, 1000.0, 1e-12);
+    EXPECT_NEAR(WorldPos(registry, ship).y, 25.0, 1e-12);
+
+    // Undocked ships keep their last world transform and stop following.
+    registry.AdvanceTick();
+    registry.RemoveComponent<ednms::ParentComponent>(ship);
+    registry.GetComponent<ednms::TransformComponent>(station)->position.x = 2000.0;
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 0u);
+    EXPECT_NEAR(WorldPos(registry, ship).x, 1000.0, 1e-12);
+
+    // Destroying a parent detaches its children on the next rebuild.
+    registry.AdvanceTick();
+    ednms::EntityID pod = Attach(registry, station, {1.0, 0.0, 0.0});
+    hierarchy.Update();
+    EXPECT_NEAR(WorldPos(registry, pod).x, 2001.0, 1e-12);
+    registry.AdvanceTick();
+    registry.DestroyEntity(station);
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 0u);
+    return true;
+}
+
+TEST(TransformHierarchy, CyclesAreSkipped) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    registry.AdvanceTick();
+
+    ednms::EntityID root = SpawnRoot(registry, {1.0, 2.0, 3.0});
+    ednms::EntityID x = Attach(registry, root, {1.0, 0.0, 0.0});
+    ednms::EntityID y = Attach(registry, x, {1.0, 0.0, 0.0});
+    registry.GetComponent<ednms::ParentComponent>(x)->parent = y;   // x <-> y
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 0u);
+    EXPECT_NEAR(WorldPos(registry, y).x, 0.0, 1e-12);
+    return true;
+}
+
+TEST(TransformHierarchy, ParallelMatchesSerial) {
+    auto build = [](ednms::ECSRegistry& registry) {
+        // 16 capital ships, each a spine of 8 sections carrying 4 modules.
+        for (int s = 0; s < 16; ++s) {
+            ednms::EntityID ship = SpawnRoot(registry, {s * 1000.0, 0.0, 0.0}, YawQuarterTurn());
+            ednms::EntityID spine = ship;
+            for (int i = 0; i < 8; ++i) {
+                spine = Attach(registry, spine, {0.0, 0.0, 12.0});
+                for (int m = 0; m < 4; ++m) Attach(registry, spine, {m * 2.0 - 3.0, 1.0, 0.0});
+            }
+        }
+    };
+
+    ednms::ECSRegistry serialRegistry;
+    ednms::ECSRegistry parallelRegistry;
+    ednms::TransformHierarchy serial(serialRegistry);
+    ednms::TransformHierarchy parallel(parallelRegistry);
+    serialRegistry.AdvanceTick();
+    parallelRegistry.AdvanceTick();
+    build(serialRegistry);
+    build(parallelRegistry);
+    serial.Update();
+
+    // A caller-owned worker pool driving the split API.
+    const size_t workers = 4;
+    const size_t dirty = parallel.BeginUpdate();
+    std::vector<size_t> bounds;
+    parallel.SplitDirtyTrees(workers, bounds);
+    EXPECT_EQ(bounds.size(), workers + 1);
+    EXPECT_EQ(bounds.front(), 0u);
+    EXPECT_EQ(bounds.back(), dirty);
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        EXPECT_TRUE(bounds[w] <= bounds[w + 1]);
+        threads.emplace_back([&, w]() { parallel.PropagateRoots(bounds[w], bounds[w + 1]); });
+    }
+    for (auto& t : threads) t.join();
+    parallel.EndUpdate();
+
+    EXPECT_EQ(parallel.Stats().nodes, 16u * (1 + 8 * 5));
+    EXPECT_EQ(parallel.Stats().maxDepth, 9u);
+    EXPECT_EQ(parallel.Stats().nodesUpdated, 16u * 8 * 5);
+    for (ednms::EntityID id = 1; id <= serialRegistry.EntityCount(); ++id) {
+        EXPECT_TRUE(WorldPos(serialRegistry, id) == WorldPos(parallelRegistry, id));
+    }
+    return true;
+}
+
+TEST(TransformHierarchy, RootMovedAfterUpdateInSameTick) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    registry.AdvanceTick();
+
+    ednms::EntityID root = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    ednms::EntityID child = Attach(registry, root, {1.0, 0.0, 0.0});
+    hierarchy.Update();
+    EXPECT_NEAR(WorldPos(registry, child).x, 1.0, 1e-12);
+
+    // A late system moves the root after the hierarchy ran this tick; the
+    // next tick's update must still see that write.
+    registry.GetComponent<ednms::TransformComponent>(root)->position.x = 100.0;
+    registry.AdvanceTick();
+    hierarchy.Update();
+    EXPECT_NEAR(WorldPos(registry, child).x, 101.0, 1e-12);
+    return true;
+}
+
+TEST(TransformHierarchy, TrimsHistoryItTracks) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    ednms::EntityID root = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    Attach(registry, root, {1.0, 0.0, 0.0});
+    for (int tick = 0; tick < 50; ++tick) {
+        registry.AdvanceTick();
+        registry.GetComponent<ednms::TransformComponent>(root)->position.x += 1.0;
+        hierarchy.Update();
+        // Nothing consumed is retained, including the children written by Update().
+        EXPECT_TRUE(registry.GetChangedSince<ednms::TransformComponent>(0).empty());
+        EXPECT_TRUE(registry.GetAddedSince<ednms::LocalTransformComponent>(0).empty());
+    }
+    return true;
+}
+
+TEST(TransformHierarchy, LeavesForeignTrackingUntrimmed) {
+    ednms::ECSRegistry registry;
+    // Another system already consumes Transform events and trims them itself.
+    registry.EnableChangeTracking<ednms::TransformComponent>();
+    ednms::TransformHierarchy hierarchy(registry);
+    ednms::EntityID root = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    Attach(registry, root, {1.0, 0.0, 0.0});
+    hierarchy.Update();
+    EXPECT_FALSE(registry.GetChangedSince<ednms::TransformComponent>(0).empty());
+    EXPECT_TRUE(registry.GetAddedSince<ednms::ParentComponent>(0).empty());
+    return true;
+}
+
+TEST(TransformHierarchy, UnrelatedSpawnsDoNotRebuild) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    ednms::EntityID ship = SpawnRoot(registry, {0.0, 0.0, 0.0});
+    for (int m = 0; m < 100; ++m) Attach(registry, ship, {static_cast<double>(m), 0.0, 0.0});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().rebuilds, 1u);
+
+    // Projectiles and debris come and go every tick.
+    std::vector<ednms::EntityID> debris;
+    for (int tick = 0; tick < 10; ++tick) {
+        registry.AdvanceTick();
+        ednms::EntityID e = registry.CreateEntity();
+        registry.AddComponent(e, ednms::TransformComponent{});
+        debris.push_back(e);
+        if (tick % 3 == 2) {
+            registry.DestroyEntity(debris.front());
+            debris.erase(debris.begin());
+        }
+        hierarchy.Update();
+        EXPECT_EQ(hierarchy.Stats().rebuilds, 1u);
+        EXPECT_EQ(hierarchy.Stats().dirtyRoots, 0u);
+    }
+    return true;
+}
+
+TEST(TransformHierarchy, OrphanAttachesWhenParentGainsTransform) {
+    ednms::ECSRegistry registry;
+    ednms::TransformHierarchy hierarchy(registry);
+    ednms::EntityID pad = registry.CreateEntity();   // no transform yet
+    ednms::EntityID ship = Attach(registry, pad, {0.0, 5.0, 0.0});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 0u);
+
+    registry.AdvanceTick();
+    registry.AddComponent(pad, ednms::TransformComponent{{10.0, 0.0, 0.0}, ednms::Quatd::Identity()});
+    hierarchy.Update();
+    EXPECT_EQ(hierarchy.Stats().nodes, 2u);
+    EXPECT_NEAR(WorldPos(registry, ship).x, 10.0, 1e-12);
+    EXPECT_NEAR(WorldPos(registry, ship).y, 5.0, 1e-12);
+    return true;
+}